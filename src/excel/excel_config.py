@@ -12,8 +12,10 @@ source_files += [
         'src/excel/numformat/nf_calendar.cpp',
         'src/excel/numformat/nf_localedata.cpp',
         'src/excel/numformat/nf_zformat.cpp',
+        'src/excel/xlsx/generate_xlsx.cpp',
         'src/excel/xlsx/read_xlsx.cpp',
         'src/excel/xlsx/write_xlsx.cpp',
+        'src/excel/xlsx/xlsx_cache.cpp',
         'src/excel/xlsx/zip_file.cpp',
     ]
 ]
@@ -9,6 +9,7 @@
 #include "nf_localedata.h"
 #include "nf_zformat.h"
 #include "xlsx/read_xlsx.hpp"
+#include "xlsx/xlsx_cache.hpp"
 
 #include <duckdb/common/types/time.hpp>
 
@@ -82,6 +83,8 @@ static void LoadInternal(ExtensionLoader &loader) {
 	// Register the XLSX functions
 	ReadXLSX::Register(loader);
 	WriteXLSX::Register(loader);
+	GenerateXLSX::Register(loader);
+	XLSXCache::Register(loader);
 }
 
 void ExcelExtension::Load(ExtensionLoader &loader) {
@@ -1,10 +1,15 @@
 #pragma once
 
+#include "xlsx/xlsb_util.hpp"
 #include "xlsx/xml_parser.hpp"
 #include "xlsx/string_table.hpp"
 
 namespace duckdb {
 
+// The shared strings of a workbook, which are records in binary workbooks
+static constexpr char XLSX_SHARED_STRINGS_ENTRY[] = "xl/sharedStrings.xml";
+static constexpr char XLSB_SHARED_STRINGS_ENTRY[] = "xl/sharedStrings.bin";
+
 //-------------------------------------------------------------------
 // Base Shared Strings Parser
 //-------------------------------------------------------------------
@@ -13,6 +18,36 @@ namespace duckdb {
 // and SharedStringParser classes.
 //-------------------------------------------------------------------
 class SharedStringParserBase : public XMLParser {
+public:
+	// Parse the shared strings, either XML ("sharedStrings.xml") or binary records ("sharedStrings.bin")
+	void ParseStrings(ZipFileReader &stream, const bool binary) {
+		if (!binary) {
+			ParseAll(stream);
+			return;
+		}
+		ReadXLSBRecords(stream, [&](const uint32_t type, XLSBRecordReader &reader) {
+			switch (type) {
+			case XLSB_BEGIN_SST:
+				// The total and unique number of strings
+				reader.ReadUInt32();
+				OnUniqueCount(reader.ReadUInt32());
+				return true;
+			case XLSB_SST_ITEM:
+				// Skip the flags of the rich string, the formatting runs and phonetic text come after the text
+				reader.ReadByte();
+				data.clear();
+				reader.ReadWideString(data);
+				OnString(data);
+				data.clear();
+				return GetStatus() != XMLParseResult::ABORTED;
+			case XLSB_END_SST:
+				return false;
+			default:
+				return true;
+			}
+		});
+	}
+
 protected:
 	virtual void OnUniqueCount(idx_t count) {
 	}
@@ -153,9 +188,9 @@ private:
 //-------------------------------------------------------------------
 class SharedStringParser final : public SharedStringParserBase {
 public:
-	static void ParseStringTable(ZipFileReader &stream, StringTable &table) {
+	static void ParseStringTable(ZipFileReader &stream, StringTable &table, const bool binary) {
 		SharedStringParser parser(table);
-		parser.ParseAll(stream);
+		parser.ParseStrings(stream, binary);
 	}
 
 private:
@@ -1,3 +1,4 @@
+#include "xlsx/xlsb_util.hpp"
 #include "xlsx/xml_parser.hpp"
 
 namespace duckdb {
@@ -7,11 +8,19 @@ public:
 	unordered_map<idx_t, LogicalType> number_formats;
 	vector<LogicalType> cell_styles;
 
+	// Parse the styles of a binary workbook ("styles.bin") instead of XML
+	void ParseRecords(ZipFileReader &stream);
+
 protected:
 	void OnStartElement(const char *name, const char **atts) override;
 	void OnEndElement(const char *name) override;
 
 private:
+	void AddNumberFormat(idx_t id, const char *format);
+	void AddCellStyle(idx_t id);
+
+	bool in_cell_xfs = false;
+
 	template <class... ARGS>
 	static bool StringContainsAny(const char *str, ARGS &&...args) {
 		for (auto &&substr : {args...}) {
@@ -55,23 +64,8 @@ inline void XLSXStyleParser::OnStartElement(const char *name, const char **atts)
 		if (!id_ptr) {
 			throw InvalidInputException("Invalid numFmt entry in styles.xml");
 		}
-		const auto id = strtol(id_ptr, nullptr, 10);
-		if (id <= 163 || format_ptr == nullptr) {
-			break;
-		}
-
-		const auto has_date_part = StringContainsAny(format_ptr, "DD", "dd", "YY", "yy");
-		const auto has_time_part = StringContainsAny(format_ptr, "HH", "hh", "h", "H");
-
-		if (has_date_part && has_time_part) {
-			number_formats.emplace(id, LogicalType::TIMESTAMP);
-		} else if (has_date_part) {
-			number_formats.emplace(id, LogicalType::DATE);
-		} else if (has_time_part) {
-			number_formats.emplace(id, LogicalType::TIME);
-		} else {
-			// If we dont know how to handle the format, default to the numeric value.
-			number_formats.emplace(id, LogicalType::DOUBLE); // TODO: Or double?
+		if (format_ptr) {
+			AddNumberFormat(strtol(id_ptr, nullptr, 10), format_ptr);
 		}
 	} break;
 	case State::CELLXFS: {
@@ -86,32 +80,87 @@ inline void XLSXStyleParser::OnStartElement(const char *name, const char **atts)
 		if (!id_ptr) {
 			throw InvalidInputException("Invalid xf entry in styles.xml");
 		}
-		const auto id = strtol(id_ptr, nullptr, 10);
-		if (id < 164) {
-			// Special cases
-			if (id >= 14 && id <= 17) {
-				cell_styles.push_back(LogicalType::DATE);
-			} else if (id >= 18 && id <= 21) {
-				cell_styles.push_back(LogicalType::TIME);
-			} else if (id == 22) {
-				cell_styles.push_back(LogicalType::TIMESTAMP);
-			} else {
-				// Else, just push a double
-				cell_styles.push_back(LogicalType::DOUBLE);
-			}
-		} else {
-			// Look up the ID in the format map
-			const auto it = number_formats.find(id);
-			if (it != number_formats.end()) {
-				cell_styles.push_back(it->second);
-			}
-		}
+		AddCellStyle(strtol(id_ptr, nullptr, 10));
 	} break;
 	default:
 		break;
 	}
 }
 
+inline void XLSXStyleParser::AddNumberFormat(const idx_t id, const char *format) {
+	if (id <= 163) {
+		return;
+	}
+
+	const auto has_date_part = StringContainsAny(format, "DD", "dd", "YY", "yy");
+	const auto has_time_part = StringContainsAny(format, "HH", "hh", "h", "H");
+
+	if (has_date_part && has_time_part) {
+		number_formats.emplace(id, LogicalType::TIMESTAMP);
+	} else if (has_date_part) {
+		number_formats.emplace(id, LogicalType::DATE);
+	} else if (has_time_part) {
+		number_formats.emplace(id, LogicalType::TIME);
+	} else {
+		// If we dont know how to handle the format, default to the numeric value.
+		number_formats.emplace(id, LogicalType::DOUBLE); // TODO: Or double?
+	}
+}
+
+inline void XLSXStyleParser::AddCellStyle(const idx_t id) {
+	if (id < 164) {
+		// Special cases
+		if (id >= 14 && id <= 17) {
+			cell_styles.push_back(LogicalType::DATE);
+		} else if (id >= 18 && id <= 21) {
+			cell_styles.push_back(LogicalType::TIME);
+		} else if (id == 22) {
+			cell_styles.push_back(LogicalType::TIMESTAMP);
+		} else {
+			// Else, just push a double
+			cell_styles.push_back(LogicalType::DOUBLE);
+		}
+	} else {
+		// Look up the ID in the format map
+		const auto it = number_formats.find(id);
+		if (it != number_formats.end()) {
+			cell_styles.push_back(it->second);
+		}
+	}
+}
+
+inline void XLSXStyleParser::ParseRecords(ZipFileReader &stream) {
+	vector<char> format;
+	ReadXLSBRecords(stream, [&](const uint32_t type, XLSBRecordReader &reader) {
+		switch (type) {
+		case XLSB_FMT: {
+			const auto id = reader.ReadUInt16();
+			format.clear();
+			reader.ReadWideString(format);
+			format.push_back('\0');
+			AddNumberFormat(id, format.data());
+			break;
+		}
+		case XLSB_BEGIN_CELL_XFS:
+			in_cell_xfs = true;
+			break;
+		case XLSB_END_CELL_XFS:
+			// The cell styles are the last ones we need
+			return false;
+		case XLSB_XF:
+			// The parent style, and then the number format. The cell style formats (cellStyleXfs) are not needed.
+			if (in_cell_xfs) {
+				reader.ReadUInt16();
+				AddCellStyle(reader.ReadUInt16());
+			}
+			break;
+		default:
+			break;
+		}
+		return true;
+	});
+}
+
 inline void XLSXStyleParser::OnEndElement(const char *name) {
 	switch (state) {
 	case State::NUMFMT:
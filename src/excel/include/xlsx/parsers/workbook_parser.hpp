@@ -1,5 +1,6 @@
 #pragma once
 
+#include "xlsx/xlsb_util.hpp"
 #include "xlsx/xml_parser.hpp"
 
 namespace duckdb {
@@ -15,6 +16,31 @@ public:
 		return std::move(parser.sheets);
 	}
 
+	// Get the (name, relationship id) of the sheets of a binary workbook ("xl/workbook.bin")
+	static vector<pair<string, string>> GetBinarySheets(ZipFileReader &stream) {
+		vector<pair<string, string>> sheets;
+		vector<char> rel_id;
+		vector<char> name;
+		ReadXLSBRecords(stream, [&](const uint32_t type, XLSBRecordReader &reader) {
+			if (type != XLSB_BUNDLE_SH) {
+				return true;
+			}
+			// The visibility and the tab id, then the relationship id (if any) and the name
+			reader.ReadUInt32();
+			reader.ReadUInt32();
+			rel_id.clear();
+			name.clear();
+			const auto has_rel_id = reader.ReadNullableWideString(rel_id);
+			reader.ReadWideString(name);
+			if (!has_rel_id) {
+				throw InvalidInputException("Invalid sheet entry in workbook.bin");
+			}
+			sheets.emplace_back(string(name.data(), name.size()), string(rel_id.data(), rel_id.size()));
+			return true;
+		});
+		return sheets;
+	}
+
 private:
 	void OnStartElement(const char *name, const char **atts) override;
 	void OnEndElement(const char *name) override;
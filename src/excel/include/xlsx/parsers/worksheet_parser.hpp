@@ -1,6 +1,11 @@
 #pragma once
 
+#include "xlsx/xlsb_util.hpp"
 #include "xlsx/xml_parser.hpp"
+#include "xlsx/xml_util.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/timestamp.hpp"
 
 namespace duckdb {
 
@@ -9,6 +14,19 @@ namespace duckdb {
 //-------------------------------------------------------------------
 // Traverses the worksheet, extracts the data from cells and calls
 // the appropriate callbacks.
+//
+// The rows in the sheet data can also be tokenized directly, without
+// going through expat, by using ParseRows() and ResumeRows() instead
+// of Parse() and Resume(). Expat still parses everything up to the
+// sheet data, as well as any row containing markup the tokenizer does
+// not handle (comments, CDATA, unknown entities, invalid references).
+//
+// The sheets of binary workbooks (.xlsb) are record streams instead,
+// which ParseRows() and ResumeRows() decode once SetBinary() is
+// called. Their numbers, booleans and shared string indices are
+// passed to OnNumberCell() as they were decoded, everything else to
+// the same callbacks as XML cells, with the data formatted as it
+// would appear in the XML of the sheet.
 //-------------------------------------------------------------------
 class SheetParserBase : public XMLParser {
 public:
@@ -16,13 +34,72 @@ public:
 	void OnStartElement(const char *name, const char **atts) override;
 	void OnEndElement(const char *name) override;
 
+	// Set the row number of the first row, in case it has no explicit row reference.
+	// Used when parsing a segment of the sheet that does not start at the first row.
+	void SetFirstRow(const idx_t row_idx) {
+		cell_pos.row = row_idx - 1;
+	}
+
+	XMLParseResult ParseRows(const char *buffer, idx_t len, bool final);
+	XMLParseResult ResumeRows();
+
+	// Parse the sheet as binary records (the sheets of xlsb workbooks) instead of XML
+	void SetBinary() {
+		phase = Phase::RECORDS;
+	}
+	bool IsBinary() const {
+		return phase == Phase::RECORDS;
+	}
+	// Parse the current entry of the stream until it ends or the parser is stopped, as ParseAll() does for XML
+	void ParseSheet(ZipFileReader &stream, idx_t buffer_size = 2048);
+
+	// Only capture the data of the cells in the given (sheet) columns. The cells of all other columns are passed
+	// to OnSkippedCell instead, without copying or decoding their data.
+	void SetCapturedColumns(vector<bool> columns) {
+		captured_columns = std::move(columns);
+		capture_all = false;
+	}
+
+	// Skip the rows before the given row without decoding their cells or calling any callback for them, for parsers
+	// that ignore those rows anyway. Only rows that are tokenized directly are skipped.
+	void SetSkippedRows(const idx_t row_idx) {
+		skip_rows_before = row_idx;
+	}
+
+	// The <dimension> of the sheet (the range of all its cells, inclusive), if the sheet has one. Only known once
+	// the parser got past the start of the sheet data.
+	bool HasDimension() const {
+		return has_dimension;
+	}
+	const XLSXCellRange &GetDimension() const {
+		return dimension;
+	}
+
 protected:
+	// The size of the markup of the current row
+	idx_t GetRowSize() const {
+		return row_size;
+	}
+
 	virtual void OnBeginRow(idx_t row_idx) {};
 	virtual void OnEndRow(idx_t row_idx) {};
 	virtual void OnCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style) {
 	}
+	// A cell of a binary sheet holding a number, a boolean (0 or 1) or a shared string index (SHARED_STRING). Unless
+	// overridden, it is passed to OnCell() as the text it would have in XML.
+	virtual void OnNumberCell(const XLSXCellPos &pos, XLSXCellType type, double number, idx_t style) {
+		cell_data.clear();
+		AppendXLSBNumber(number, cell_data);
+		OnCell(pos, type, cell_data, style);
+	}
+	virtual void OnSkippedCell(const XLSXCellPos &pos, bool has_data) {
+	}
 
 private:
+	bool IsCaptured(const idx_t col) const {
+		return capture_all || (col < captured_columns.size() && captured_columns[col]);
+	}
+
 	enum class State : uint8_t { START, SHEETDATA, ROW, EMPTY_ROW, CELL, V, IS, T };
 	State state = State::START;
 
@@ -30,9 +107,84 @@ private:
 	XLSXCellType cell_type = XLSXCellType::NUMBER;
 	vector<char> cell_data = {};
 	idx_t cell_style = 0;
+
+	bool capture_all = true;
+	vector<bool> captured_columns;
+	// Whether the data of the current cell is captured, and if not, whether it has any
+	bool cell_captured = true;
+	bool cell_has_data = false;
+
+	bool has_dimension = false;
+	XLSXCellRange dimension;
+	// The offset of the current row, if it is parsed by expat, and its size
+	idx_t row_offset = 0;
+	idx_t row_size = 0;
+
+private:
+	// Tokenizer
+	static bool IsUTF8(const char *buffer, idx_t len);
+	static const char *FindCommentEnd(const char *ptr, const char *end);
+	static const char *FindRowEnd(const char *tag_end, const char *end);
+	XMLParseResult ScanRows(const char *buffer, idx_t len);
+	XMLParseResult TokenizeRows(const char *&ptr, const char *end);
+	bool TrySkipRow(const char *beg, const char *tag_end);
+	bool TryDecodeRow(const char *beg, const char *tag_end, const char *end);
+	XMLParseResult EmitRow();
+	XMLParseResult ParseWithExpat(const char *buffer, idx_t len, bool final);
+
+	// Record tokenizer
+	XMLParseResult ScanRecords(const char *buffer, idx_t len);
+	XMLParseResult TokenizeRecords(const char *&ptr, const char *end);
+	void DecodeRecordCell(uint32_t type, const char *data, idx_t size);
+
+	// START: not tokenizing, PROLOGUE: expat parses up to the sheet data,
+	// ROWS: rows are tokenized, EXPAT: expat parses the rest of the sheet,
+	// RECORDS: the sheet is binary, all of it is tokenized
+	enum class Phase : uint8_t { START, PROLOGUE, ROWS, EXPAT, RECORDS };
+	Phase phase = Phase::START;
+	bool is_final = false;
+
+	// The number of bytes passed to expat before the current buffer, and the offset of the rows
+	idx_t prologue_size = 0;
+	idx_t rows_offset = 0;
+	// Whether expat has been handed a sheetData start tag since it was reset
+	bool expat_in_sheet_data = false;
+	// Whether expat is parsing a row the tokenizer did not handle
+	bool expat_row = false;
+
+	// Input that has not been tokenized yet
+	vector<char> pending;
+	// The rows before this one are skipped
+	idx_t skip_rows_before = 0;
+
+	struct RowCell {
+		XLSXCellPos pos;
+		XLSXCellType type;
+		idx_t style;
+		// The range of the cell data in row_data
+		idx_t data_beg;
+		idx_t data_end;
+		// Whether the data is captured, and if not, whether there is any
+		bool is_captured;
+		bool has_data;
+		// Whether the cell of a binary sheet holds a decoded number instead of data
+		bool is_number;
+		double number;
+	};
+	// The decoded row being emitted, and how far we got (the row begin, every cell and the row end)
+	vector<RowCell> row_cells;
+	vector<char> row_data;
+	idx_t emit_idx = 0;
+	bool is_emitting = false;
+	// Whether the cell records of a row are being decoded into row_cells
+	bool is_record_row = false;
 };
 
 inline void SheetParserBase::OnText(const char *text, idx_t len) {
+	if (!cell_captured) {
+		cell_has_data = cell_has_data || len > 0;
+		return;
+	}
 	if (cell_data.size() + len > XLSX_MAX_CELL_SIZE * 2) {
 		// Something is obviously wrong, error out!
 		throw InvalidInputException("XLSX: Cell data too large (is the file corrupted?)");
@@ -41,10 +193,31 @@ inline void SheetParserBase::OnText(const char *text, idx_t len) {
 }
 
 inline void SheetParserBase::OnStartElement(const char *name, const char **atts) {
-	if (state == State::START && MatchTag("sheetData", name)) {
+	if (state == State::START && MatchTag("dimension", name)) {
+		for (idx_t i = 0; atts[i]; i += 2) {
+			if (strcmp(atts[i], "ref") != 0) {
+				continue;
+			}
+			// Empty sheets only have a single cell as dimension
+			XLSXCellPos pos;
+			if (dimension.TryParse(atts[i + 1])) {
+				has_dimension = true;
+			} else if (pos.TryParse(atts[i + 1])) {
+				dimension = XLSXCellRange(pos.row, pos.col, pos.row, pos.col);
+				has_dimension = true;
+			}
+		}
+	} else if (state == State::START && MatchTag("sheetData", name)) {
 		state = State::SHEETDATA;
+		if (phase == Phase::PROLOGUE) {
+			// Tokenize the rows from here on
+			rows_offset = GetCurrentElementEnd();
+			phase = Phase::ROWS;
+			Stop(true);
+		}
 	} else if (state == State::SHEETDATA && MatchTag("row", name)) {
 		state = State::ROW;
+		row_offset = GetCurrentElementBegin();
 
 		// Reset the column position
 		cell_pos.col = 0;
@@ -102,6 +275,8 @@ inline void SheetParserBase::OnStartElement(const char *name, const char **atts)
 			}
 			cell_pos.col = cref.col;
 		}
+		cell_captured = IsCaptured(cell_pos.col);
+		cell_has_data = false;
 	} else if (state == State::CELL && MatchTag("v", name)) {
 		state = State::V;
 		EnableTextHandler(true);
@@ -117,10 +292,15 @@ inline void SheetParserBase::OnEndElement(const char *name) {
 	if (state == State::SHEETDATA && MatchTag("sheetData", name)) {
 		Stop(false);
 	} else if (state == State::ROW && MatchTag("row", name)) {
+		row_size = GetCurrentElementEnd() - row_offset;
 		OnEndRow(cell_pos.row);
 		state = State::SHEETDATA;
 	} else if (state == State::CELL && MatchTag("c", name)) {
-		OnCell(cell_pos, cell_type, cell_data, cell_style);
+		if (cell_captured) {
+			OnCell(cell_pos, cell_type, cell_data, cell_style);
+		} else {
+			OnSkippedCell(cell_pos, cell_has_data);
+		}
 		state = State::ROW;
 	} else if (state == State::V && MatchTag("v", name)) {
 		state = State::CELL;
@@ -134,94 +314,697 @@ inline void SheetParserBase::OnEndElement(const char *name) {
 }
 
 //-------------------------------------------------------------------
-// Range Sniffer
+// Sheet Data Tokenizer
 //-------------------------------------------------------------------
-// The range sniffer is used to determine the range of the sheet to scan
-// It will scan the sheet until it finds a row with data, and then use that
-// to infer the column range of the sheet
+// Worksheets are dominated by long runs of small, regular <row> and <c>
+// elements. Instead of driving expat's callbacks for every element, the
+// tokenizer buffers complete rows, locates the markup with memchr (which
+// the C library vectorizes) and decodes the cells in place.
 //-------------------------------------------------------------------
-class RangeSniffer final : public SheetParserBase {
-public:
-	XLSXCellRange GetRange() const;
+static constexpr char XLSX_SHEET_DATA_TAG[] = "<sheetData>";
 
-private:
-	void OnEndRow(idx_t row_idx) override;
-	void OnCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style) override;
+inline bool SheetParserBase::IsUTF8(const char *buffer, const idx_t len) {
+	// Byte order marks of UTF-16
+	if (len >= 2 && ((buffer[0] == '\xFF' && buffer[1] == '\xFE') || (buffer[0] == '\xFE' && buffer[1] == '\xFF'))) {
+		return false;
+	}
+	const auto end = buffer + len;
+	if (memcmp(buffer, "<?xml", MinValue<idx_t>(len, 5)) != 0) {
+		return true;
+	}
+	const auto decl_end = static_cast<const char *>(memchr(buffer, '>', len));
+	if (!decl_end) {
+		// We can't tell without the whole declaration, so play it safe
+		return false;
+	}
+	// Look for an encoding declaration
+	auto ptr = SkipXMLName(buffer + 1, end);
+	XMLRawAttribute attr;
+	while (ReadXMLAttribute(ptr, decl_end, attr)) {
+		if (attr.NameIs("encoding")) {
+			const string encoding(attr.value_beg, attr.value_end);
+			return StringUtil::CIEquals(encoding, "utf-8");
+		}
+	}
+	return true;
+}
 
-private:
-	// The range of the first consecutive non-empty row
-	idx_t beg_col = 0;
-	idx_t end_col = 0;
-	idx_t beg_row = 0;
+inline XMLParseResult SheetParserBase::ParseRows(const char *buffer, const idx_t len, const bool final) {
+	if (GetStatus() == XMLParseResult::ABORTED) {
+		return XMLParseResult::ABORTED;
+	}
+	is_final = final;
+	if (phase == Phase::RECORDS) {
+		return ScanRecords(buffer, len);
+	}
+
+	if (phase == Phase::START) {
+		// The tokenizer only understands UTF-8, leave any other encoding to expat
+		phase = IsUTF8(buffer, len) ? Phase::PROLOGUE : Phase::EXPAT;
+	}
+	switch (phase) {
+	case Phase::PROLOGUE: {
+		const auto status = Parse(buffer, len, final);
+		if (phase != Phase::ROWS || status == XMLParseResult::ABORTED) {
+			prologue_size += len;
+			return status;
+		}
+		if (rows_offset < prologue_size) {
+			// Expat buffered part of the input before it got to the sheet data (which only happens with tiny
+			// buffers), so we can't pick up from there. Let expat parse the rest of the sheet instead.
+			phase = Phase::EXPAT;
+			return Resume();
+		}
+		// Expat stopped right after the sheetData start tag. Take over from there, resetting expat
+		// so that it can still be handed rows the tokenizer does not handle.
+		const auto offset = rows_offset - prologue_size;
+		Reset();
+		return ScanRows(buffer + offset, len - offset);
+	}
+	case Phase::ROWS:
+		return ScanRows(buffer, len);
+	default:
+		return Parse(buffer, len, final);
+	}
+}
 
-	// The total range of the sheet
-	idx_t min_col = 0;
-	idx_t max_col = 0;
+inline XMLParseResult SheetParserBase::ResumeRows() {
+	const auto status = Resume();
+	if (status != XMLParseResult::OK) {
+		return status;
+	}
+	// Continue with the input left over from the last call
+	if (phase == Phase::RECORDS) {
+		return ScanRecords(nullptr, 0);
+	}
+	return phase == Phase::ROWS ? ScanRows(nullptr, 0) : status;
+}
 
-	enum class State : uint8_t { EMPTY, FOUND, ENDED };
-	State state = State::EMPTY;
-};
+inline XMLParseResult SheetParserBase::ParseWithExpat(const char *buffer, const idx_t len, const bool final) {
+	if (!expat_in_sheet_data) {
+		// Expat was reset when the tokenizer took over, so it has to be handed the start of the sheet data first
+		expat_in_sheet_data = true;
+		const auto status = Parse(XLSX_SHEET_DATA_TAG, sizeof(XLSX_SHEET_DATA_TAG) - 1, false);
+		if (status != XMLParseResult::OK) {
+			return status;
+		}
+	}
+	return Parse(buffer, len, final);
+}
+
+inline XMLParseResult SheetParserBase::ScanRows(const char *buffer, const idx_t len) {
+	// Rows may span multiple buffers, so continue from any input left over from the last call
+	const auto use_pending = !pending.empty();
+	if (use_pending) {
+		pending.insert(pending.end(), buffer, buffer + len);
+		buffer = pending.data();
+	}
+	const auto end = buffer + (use_pending ? pending.size() : len);
+
+	auto ptr = buffer;
+	auto status = TokenizeRows(ptr, end);
+	if (status == XMLParseResult::OK && is_final && phase == Phase::ROWS) {
+		// The input ended inside the sheet data, let expat report the error
+		phase = Phase::EXPAT;
+		status = ParseWithExpat(ptr, NumericCast<idx_t>(end - ptr), true);
+		ptr = end;
+	}
 
-inline XLSXCellRange RangeSniffer::GetRange() const {
-	if (beg_row == 0) {
-		// We didnt find any rows... return the whole sheet
-		return XLSXCellRange();
+	// Keep the rest of the input around, the caller is free to reuse its buffer
+	if (use_pending) {
+		pending.erase(pending.begin(), pending.begin() + (ptr - buffer));
+	} else {
+		pending.assign(ptr, end);
 	}
-	// Otherwise, return the sniffed range
-	return XLSXCellRange(beg_row, beg_col, NumericLimits<idx_t>::Maximum(), end_col + 1);
+	return status;
 }
 
-inline void RangeSniffer::OnCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style) {
-	min_col = std::min(min_col, pos.col);
-	max_col = std::max(max_col, pos.col);
+inline XMLParseResult SheetParserBase::TokenizeRows(const char *&ptr, const char *end) {
+	while (true) {
+		if (is_emitting) {
+			const auto status = EmitRow();
+			if (status != XMLParseResult::OK) {
+				return status;
+			}
+		}
+		if (expat_row) {
+			expat_row = false;
+			if (state != State::SHEETDATA) {
+				// Expat did not see the end of the row, so we lost track of it. Let expat parse the rest.
+				phase = Phase::EXPAT;
+				const auto status = Parse(ptr, NumericCast<idx_t>(end - ptr), is_final);
+				ptr = end;
+				return status;
+			}
+		}
 
-	switch (state) {
-	case State::EMPTY:
-		if (!data.empty()) {
-			state = State::FOUND;
-			beg_col = pos.col;
-			end_col = pos.col;
+		ptr = SkipXMLSpace(ptr, end);
+		if (end - ptr < 2) {
+			// Need more input
+			return XMLParseResult::OK;
 		}
-		break;
-	case State::FOUND:
-		if (data.empty()) {
-			state = State::ENDED;
+
+		if (ptr[0] == '<' && ptr[1] == '!' && (end - ptr < 4 || memcmp(ptr, "<!--", 4) == 0)) {
+			// Skip comments
+			const auto comment_end = FindCommentEnd(ptr, end);
+			if (!comment_end) {
+				return XMLParseResult::OK;
+			}
+			ptr = comment_end;
+			continue;
+		}
+
+		if (ptr[0] == '<' && ptr[1] == '/') {
+			const auto name_end = SkipXMLName(ptr + 2, end);
+			if (name_end == end) {
+				return XMLParseResult::OK;
+			}
+			if (MatchXMLName(ptr + 2, name_end, "sheetData")) {
+				// We're done
+				Stop(false);
+				return XMLParseResult::ABORTED;
+			}
+		} else if (ptr[0] == '<' && ptr[1] != '!' && ptr[1] != '?') {
+			const auto name_end = SkipXMLName(ptr + 1, end);
+			if (name_end == end) {
+				return XMLParseResult::OK;
+			}
+			if (MatchXMLName(ptr + 1, name_end, "row")) {
+				const auto tag_end = FindXMLTagEnd(name_end, end);
+				const auto row_end = tag_end ? FindRowEnd(tag_end, end) : nullptr;
+				if (!row_end) {
+					return XMLParseResult::OK;
+				}
+				const auto row_beg = ptr;
+				ptr = row_end;
+				row_size = NumericCast<idx_t>(row_end - row_beg);
+
+				if (cell_pos.row + 1 < skip_rows_before && TrySkipRow(row_beg, tag_end)) {
+					continue;
+				}
+				if (TryDecodeRow(row_beg, tag_end, row_end)) {
+					emit_idx = 0;
+					is_emitting = true;
+					continue;
+				}
+
+				// Let expat parse this row
+				expat_row = true;
+				const auto status = ParseWithExpat(row_beg, NumericCast<idx_t>(row_end - row_beg), false);
+				if (status != XMLParseResult::OK) {
+					return status;
+				}
+				continue;
+			}
+		}
+
+		// Something we do not recognize, let expat parse the rest of the sheet
+		phase = Phase::EXPAT;
+		const auto status = ParseWithExpat(ptr, NumericCast<idx_t>(end - ptr), is_final);
+		ptr = end;
+		return status;
+	}
+}
+
+// Returns the position after the comment at ptr, or nullptr if it is not complete
+inline const char *SheetParserBase::FindCommentEnd(const char *ptr, const char *end) {
+	for (auto next = ptr + 4; next < end; next++) {
+		next = static_cast<const char *>(memchr(next, '>', NumericCast<size_t>(end - next)));
+		if (!next) {
+			break;
+		}
+		if (next - ptr >= 6 && next[-1] == '-' && next[-2] == '-') {
+			return next + 1;
+		}
+	}
+	return nullptr;
+}
+
+// Returns the position after the row whose start tag ends at tag_end, or nullptr if it is not complete
+inline const char *SheetParserBase::FindRowEnd(const char *tag_end, const char *end) {
+	if (tag_end[-1] == '/') {
+		// Empty row
+		return tag_end + 1;
+	}
+	for (auto next = tag_end + 1; next < end; next++) {
+		next = static_cast<const char *>(memchr(next, '<', NumericCast<size_t>(end - next)));
+		if (!next || end - next < 2) {
+			break;
+		}
+		if (next[1] != '/') {
+			continue;
+		}
+		const auto name_end = SkipXMLName(next + 2, end);
+		if (name_end == end) {
+			break;
+		}
+		if (MatchXMLName(next + 2, name_end, "row")) {
+			const auto close = static_cast<const char *>(memchr(name_end, '>', NumericCast<size_t>(end - name_end)));
+			return close ? close + 1 : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+// Skip the row with the start tag in [beg, tag_end] if it comes before the rows to read. Only the row number is
+// decoded, the cells are not even looked at (so any error in them goes unnoticed).
+inline bool SheetParserBase::TrySkipRow(const char *beg, const char *tag_end) {
+	char value[32];
+	XMLRawAttribute attr;
+
+	// Default: Increment the row
+	auto row_idx = cell_pos.row + 1;
+	auto ptr = SkipXMLName(beg + 1, tag_end + 1);
+	while (ReadXMLAttribute(ptr, tag_end + 1, attr)) {
+		if (attr.NameIs("r")) {
+			if (!attr.TryCopyValue(value)) {
+				return false;
+			}
+			row_idx = strtol(value, nullptr, 10);
+		}
+	}
+	if (!ptr || row_idx <= cell_pos.row || row_idx >= skip_rows_before) {
+		return false;
+	}
+	cell_pos.row = row_idx;
+	cell_pos.col = 0;
+	return true;
+}
+
+// Decode the row in [beg, end), with its start tag ending at tag_end. This mirrors the state machine of the expat
+// callbacks, but returns false instead of throwing, so that expat can handle (and report) anything unusual.
+inline bool SheetParserBase::TryDecodeRow(const char *beg, const char *tag_end, const char *end) {
+	char value[32];
+	XMLRawAttribute attr;
+
+	// Default: Increment the row
+	auto row_idx = cell_pos.row + 1;
+	auto ptr = SkipXMLName(beg + 1, end);
+	while (ReadXMLAttribute(ptr, tag_end + 1, attr)) {
+		if (attr.NameIs("r")) {
+			if (!attr.TryCopyValue(value)) {
+				return false;
+			}
+			row_idx = strtol(value, nullptr, 10);
+		}
+	}
+	if (!ptr) {
+		return false;
+	}
+
+	row_cells.clear();
+	row_data.clear();
+
+	auto col = idx_t(0);
+	auto scope = State::ROW;
+	RowCell cell = {};
+
+	ptr = tag_end + 1;
+	if (tag_end[-1] == '/') {
+		// Empty row
+		ptr = end;
+		scope = State::SHEETDATA;
+	}
+	while (ptr < end) {
+		const auto next = static_cast<const char *>(memchr(ptr, '<', NumericCast<size_t>(end - ptr)));
+		if (!next) {
+			return false;
+		}
+		if ((scope == State::V || scope == State::T) && !cell.is_captured) {
+			cell.has_data = cell.has_data || next > ptr;
+			if (memchr(ptr, '&', NumericCast<size_t>(next - ptr))) {
+				// We don't need the text, but the references still have to be valid
+				const auto valid = TryUnescapeXMLText(ptr, next, row_data);
+				row_data.resize(cell.data_beg);
+				if (!valid) {
+					return false;
+				}
+			}
+		} else if (scope == State::V || scope == State::T) {
+			if (!TryUnescapeXMLText(ptr, next, row_data)) {
+				return false;
+			}
+			if (row_data.size() - cell.data_beg > XLSX_MAX_CELL_SIZE * 2) {
+				return false;
+			}
+		}
+		ptr = next;
+		if (end - ptr < 2 || ptr[1] == '!' || ptr[1] == '?') {
+			return false;
+		}
+
+		const auto is_end_tag = ptr[1] == '/';
+		const auto name_beg = ptr + (is_end_tag ? 2 : 1);
+		const auto name_end = SkipXMLName(name_beg, end);
+		auto elem_end = FindXMLTagEnd(name_end, end);
+		if (!elem_end) {
+			return false;
+		}
+		const auto is_empty = !is_end_tag && elem_end[-1] == '/';
+
+		if (!is_end_tag) {
+			if (scope == State::ROW && MatchXMLName(name_beg, name_end, "c")) {
+				scope = State::CELL;
+
+				// Parse the attributes
+				auto attr_ptr = name_end;
+				auto style = idx_t(0);
+				auto type = XLSXCellType::NUMBER;
+				auto has_ref = false;
+				XLSXCellPos cref;
+				while (ReadXMLAttribute(attr_ptr, elem_end + 1, attr)) {
+					if (attr.NameIs("t")) {
+						if (!attr.TryCopyValue(value)) {
+							return false;
+						}
+						type = ParseCellType(value);
+					} else if (attr.NameIs("r")) {
+						if (!attr.TryCopyValue(value) || !cref.TryParse(value) || cref.row != row_idx) {
+							// Let expat throw the error
+							return false;
+						}
+						has_ref = true;
+					} else if (attr.NameIs("s")) {
+						if (!attr.TryCopyValue(value)) {
+							return false;
+						}
+						style = strtol(value, nullptr, 10);
+					}
+				}
+				if (!attr_ptr) {
+					return false;
+				}
+				// Default: next cell
+				col = has_ref ? cref.col : col + 1;
+
+				cell.pos = XLSXCellPos(row_idx, col);
+				cell.type = type;
+				cell.style = style;
+				cell.data_beg = row_data.size();
+				cell.is_captured = IsCaptured(col);
+				cell.has_data = false;
+			} else if (scope == State::CELL && MatchXMLName(name_beg, name_end, "v")) {
+				scope = State::V;
+			} else if (scope == State::CELL && MatchXMLName(name_beg, name_end, "is")) {
+				scope = State::IS;
+			} else if (scope == State::IS && MatchXMLName(name_beg, name_end, "t")) {
+				scope = State::T;
+			}
+		}
+
+		if (is_end_tag || is_empty) {
+			if (scope == State::ROW && MatchXMLName(name_beg, name_end, "row")) {
+				scope = State::SHEETDATA;
+				if (elem_end + 1 != end) {
+					return false;
+				}
+			} else if (scope == State::CELL && MatchXMLName(name_beg, name_end, "c")) {
+				cell.data_end = row_data.size();
+				row_cells.push_back(cell);
+				scope = State::ROW;
+			} else if (scope == State::V && MatchXMLName(name_beg, name_end, "v")) {
+				scope = State::CELL;
+			} else if (scope == State::IS && MatchXMLName(name_beg, name_end, "is")) {
+				scope = State::CELL;
+			} else if (scope == State::T && MatchXMLName(name_beg, name_end, "t")) {
+				scope = State::IS;
+			}
+		}
+		ptr = elem_end + 1;
+	}
+	if (scope != State::SHEETDATA) {
+		return false;
+	}
+
+	cell_pos.row = row_idx;
+	cell_pos.col = col;
+	return true;
+}
+
+inline XMLParseResult SheetParserBase::EmitRow() {
+	// A callback may stop the parser, so keep track of where to continue
+	while (emit_idx < row_cells.size() + 2) {
+		const auto step = emit_idx++;
+		if (step == 0) {
+			OnBeginRow(cell_pos.row);
+		} else if (step <= row_cells.size()) {
+			const auto &cell = row_cells[step - 1];
+			if (cell.is_captured && cell.is_number) {
+				OnNumberCell(cell.pos, cell.type, cell.number, cell.style);
+			} else if (cell.is_captured) {
+				cell_data.assign(row_data.data() + cell.data_beg, row_data.data() + cell.data_end);
+				OnCell(cell.pos, cell.type, cell_data, cell.style);
+			} else {
+				OnSkippedCell(cell.pos, cell.has_data);
+			}
 		} else {
-			end_col = pos.col;
+			OnEndRow(cell_pos.row);
+		}
+		if (GetStatus() != XMLParseResult::OK) {
+			return GetStatus();
 		}
-		break;
-	case State::ENDED:
-		// We're done
-		break;
 	}
+	is_emitting = false;
+	return XMLParseResult::OK;
 }
 
-inline void RangeSniffer::OnEndRow(const idx_t row_idx) {
-	if (state == State::FOUND || state == State::ENDED) {
-		// We found a row with data, between beg_col and end_col
-		// We can now use this as the range for the sheet
-		beg_row = row_idx;
-		Stop(false);
+//-------------------------------------------------------------------
+// Sheet Record Tokenizer
+//-------------------------------------------------------------------
+// The sheet data of a binary sheet is a row header record followed by
+// a record for every cell of the row, for each row. The cells of a row
+// are decoded until the next row header (or the end of the sheet
+// data), and then emitted the same way as the rows of an XML sheet.
+//-------------------------------------------------------------------
+inline void SheetParserBase::ParseSheet(ZipFileReader &stream, const idx_t buffer_size) {
+	if (phase != Phase::RECORDS) {
+		ParseAll(stream, buffer_size);
+		return;
+	}
+	const auto buffer_handle = make_unsafe_uniq_array_uninitialized<char>(buffer_size);
+	const auto buffer = buffer_handle.get();
+
+	// Read the stream in chunks and parse it until done or cancelled, resuming if necessary
+	while (!stream.IsDone()) {
+		const char *block;
+		const auto read_size = stream.ReadBlock(buffer, buffer_size, block);
+		auto status = ParseRows(block, read_size, stream.IsDone());
+		while (status == XMLParseResult::SUSPENDED) {
+			status = ResumeRows();
+		}
+		if (status == XMLParseResult::ABORTED) {
+			return;
+		}
+	}
+}
+
+inline XMLParseResult SheetParserBase::ScanRecords(const char *buffer, const idx_t len) {
+	// Records may span multiple buffers, so continue from any input left over from the last call
+	const auto use_pending = !pending.empty();
+	if (use_pending) {
+		pending.insert(pending.end(), buffer, buffer + len);
+		buffer = pending.data();
+	}
+	const auto end = buffer + (use_pending ? pending.size() : len);
+
+	auto ptr = buffer;
+	const auto status = TokenizeRecords(ptr, end);
+
+	// Keep the rest of the input around, the caller is free to reuse its buffer
+	if (use_pending) {
+		pending.erase(pending.begin(), pending.begin() + (ptr - buffer));
 	} else {
-		// Reset, continue on to the next row
-		state = State::EMPTY;
-		beg_col = 0;
-		end_col = 0;
+		pending.assign(ptr, end);
 	}
+	return status;
+}
+
+inline XMLParseResult SheetParserBase::TokenizeRecords(const char *&ptr, const char *end) {
+	while (true) {
+		if (is_emitting) {
+			const auto status = EmitRow();
+			if (status != XMLParseResult::OK) {
+				return status;
+			}
+		}
+
+		auto data = ptr;
+		uint32_t type = 0;
+		uint32_t size = 0;
+		const auto is_complete =
+		    TryReadXLSBRecordHeader(data, end, type, size) && static_cast<idx_t>(end - data) >= size;
+		if (!is_complete && !is_final) {
+			// Need more input
+			return XMLParseResult::OK;
+		}
+		if (!is_complete && ptr != end) {
+			throw InvalidInputException("XLSB: Unexpected end of sheet (is the file corrupted?)");
+		}
+
+		const auto is_row_end = !is_complete || type == XLSB_ROW_HDR || type == XLSB_END_SHEET_DATA;
+		if (is_row_end && is_record_row) {
+			// Emit the row first, the record is handled once that is done
+			is_record_row = false;
+			emit_idx = 0;
+			is_emitting = true;
+			continue;
+		}
+		if (!is_complete || type == XLSB_END_SHEET_DATA) {
+			// We're done
+			Stop(false);
+			return XMLParseResult::ABORTED;
+		}
+		const auto record_size = NumericCast<idx_t>(data + size - ptr);
+		ptr = data + size;
+
+		const auto is_cell = (type >= XLSB_CELL_BLANK && type <= XLSB_SHORT_ISST) || type == XLSB_CELL_RSTRING;
+		if (is_cell) {
+			if (is_record_row) {
+				DecodeRecordCell(type, data, size);
+				row_size += record_size;
+			}
+			continue;
+		}
+		switch (type) {
+		case XLSB_ROW_HDR: {
+			XLSBRecordReader reader(data, size);
+			cell_pos.row = idx_t(reader.ReadUInt32()) + 1;
+			cell_pos.col = 0;
+			row_size = record_size;
+			if (cell_pos.row < skip_rows_before) {
+				// Skip the row, its cells are not even looked at
+				break;
+			}
+			row_cells.clear();
+			row_data.clear();
+			is_record_row = true;
+			break;
+		}
+		case XLSB_WS_DIM: {
+			// The range of all cells (0-indexed, inclusive)
+			XLSBRecordReader reader(data, size);
+			const auto beg_row = idx_t(reader.ReadUInt32()) + 1;
+			const auto end_row = idx_t(reader.ReadUInt32()) + 1;
+			const auto beg_col = idx_t(reader.ReadUInt32()) + 1;
+			const auto end_col = idx_t(reader.ReadUInt32()) + 1;
+			dimension = XLSXCellRange(beg_row, beg_col, end_row, end_col);
+			has_dimension = true;
+			break;
+		}
+		default:
+			// Anything else (formats, merged cells, ...) does not matter
+			break;
+		}
+	}
+}
+
+// Decode a cell record of the current row into row_cells. Numbers, booleans and shared string indices are kept as
+// they were decoded, the text of error and string cells is formatted as it would be in XML.
+inline void SheetParserBase::DecodeRecordCell(const uint32_t type, const char *data, const idx_t size) {
+	XLSBRecordReader reader(data, size);
+
+	// Short cells don't have a column, they follow the previous cell
+	const auto is_short = type >= XLSB_SHORT_BLANK && type <= XLSB_SHORT_ISST;
+	cell_pos.col = is_short ? cell_pos.col + 1 : idx_t(reader.ReadUInt32()) + 1;
+
+	RowCell cell = {};
+	cell.pos = XLSXCellPos(cell_pos.row, cell_pos.col);
+	cell.type = XLSXCellType::NUMBER;
+	// The style is in the lower 24 bits, the rest are flags
+	cell.style = reader.ReadUInt32() & 0xFFFFFF;
+	cell.data_beg = row_data.size();
+	cell.is_captured = IsCaptured(cell_pos.col);
+	// Every cell but a blank one has data, which is only decoded if it is captured
+	cell.has_data = type != XLSB_CELL_BLANK && type != XLSB_SHORT_BLANK;
+
+	switch (type) {
+	case XLSB_CELL_BLANK:
+	case XLSB_SHORT_BLANK:
+		break;
+	case XLSB_CELL_RK:
+	case XLSB_SHORT_RK:
+		if (cell.is_captured) {
+			cell.is_number = true;
+			cell.number = DecodeXLSBRkNumber(reader.ReadUInt32());
+		}
+		break;
+	case XLSB_CELL_REAL:
+	case XLSB_SHORT_REAL:
+	case XLSB_FMLA_NUM:
+		if (cell.is_captured) {
+			cell.is_number = true;
+			cell.number = reader.ReadDouble();
+		}
+		break;
+	case XLSB_CELL_BOOL:
+	case XLSB_SHORT_BOOL:
+	case XLSB_FMLA_BOOL:
+		cell.type = XLSXCellType::BOOLEAN;
+		if (cell.is_captured) {
+			cell.is_number = true;
+			cell.number = reader.ReadByte() ? 1 : 0;
+		}
+		break;
+	case XLSB_CELL_ERROR:
+	case XLSB_SHORT_ERROR:
+	case XLSB_FMLA_ERROR:
+		cell.type = XLSXCellType::ERROR;
+		if (cell.is_captured) {
+			const auto text = GetXLSBErrorText(reader.ReadByte());
+			row_data.insert(row_data.end(), text, text + strlen(text));
+		}
+		break;
+	case XLSB_CELL_ISST:
+	case XLSB_SHORT_ISST:
+		cell.type = XLSXCellType::SHARED_STRING;
+		if (cell.is_captured) {
+			cell.is_number = true;
+			cell.number = static_cast<double>(reader.ReadUInt32());
+		}
+		break;
+	case XLSB_CELL_ST:
+	case XLSB_SHORT_ST:
+	case XLSB_FMLA_STRING:
+	case XLSB_CELL_RSTRING:
+		cell.type = type == XLSB_FMLA_STRING ? XLSXCellType::FORMULA_STRING : XLSXCellType::INLINE_STRING;
+		if (type == XLSB_CELL_RSTRING) {
+			// Skip the flags of the rich string, the formatting runs come after the text
+			reader.Skip(1);
+		}
+		if (cell.is_captured) {
+			reader.ReadWideString(row_data);
+		} else {
+			cell.has_data = reader.SkipWideString() > 0;
+		}
+		break;
+	default:
+		throw InternalException("Unexpected cell record in xlsb sheet");
+	}
+
+	cell.data_end = row_data.size();
+	row_cells.push_back(cell);
 }
 
 //-------------------------------------------------------------------
 // Header Sniffer
 //-------------------------------------------------------------------
 // The header sniffer is used to determine the header and the types
-// of the columns in the sheet (within the range)
+// of the columns in the sheet (within the range).
+//
+// If no range is given, it is sniffed in the same pass: the first
+// row with data determines the first row of the range, and its first
+// consecutive non-empty cells determine the columns. If no row has
+// any data, the first row of the sheet is used as it is, limited to
+// the columns of the <dimension> of the sheet if it has a valid one.
 //-------------------------------------------------------------------
 class HeaderSniffer final : public SheetParserBase {
 public:
 	HeaderSniffer(const XLSXCellRange &range_p, const XLSXHeaderMode header_mode_p, const bool absolute_range_p,
-	              XLSXCellType default_cell_type_p)
+	              XLSXCellType default_cell_type_p, const bool sniff_range_p, const XLSXStyleSheet &style_sheet_p,
+	              const bool all_varchar_p, const idx_t sample_size_p, const bool stop_at_empty_p)
 	    : range(range_p), header_mode(header_mode_p), absolute_range(absolute_range_p),
-	      default_cell_type(default_cell_type_p) {
+	      default_cell_type(default_cell_type_p), sniff_range(sniff_range_p), style_sheet(style_sheet_p),
+	      all_varchar(all_varchar_p), sample_size(MaxValue<idx_t>(sample_size_p, 1)), stop_at_empty(stop_at_empty_p) {
 	}
 
 	const XLSXCellRange &GetRange() const {
@@ -233,12 +1016,38 @@ public:
 	vector<XLSXCell> &GetHeaderCells() {
 		return header_cells;
 	}
+	// Whether the range is known, which is only not the case if it had to be sniffed and no row has any data
+	bool HasRange() const {
+		return !sniff_range;
+	}
+	// The size of the markup of the first data row, or 0 if it is not known
+	idx_t GetSampledRowSize() const {
+		return sampled_row_size;
+	}
+	// If the range had to be sniffed but no row has any data, use the first row of the sheet instead
+	void UseFirstRow();
+	// Whether any data row was sampled
+	bool HasDataRow() const {
+		return sampled_rows > 0;
+	}
+	// The types of the columns, widened to fit all the sampled data rows
+	const vector<LogicalType> &GetColumnTypes() const {
+		return column_types;
+	}
+	const vector<XLSXCellType> &GetSourceTypes() const {
+		return source_types;
+	}
 
 private:
 	void OnBeginRow(idx_t row_idx) override;
 	void OnEndRow(idx_t row_idx) override;
 	void OnCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style) override;
 
+	void AddCell(XLSXCellType type, const XLSXCellPos &pos, string data, idx_t style);
+	void SniffRangeCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style);
+	void SniffRangeEndRow(idx_t row_idx);
+	void SampleDataRow();
+
 private:
 	vector<XLSXCell> header_cells;
 	vector<XLSXCell> column_cells;
@@ -251,9 +1060,69 @@ private:
 	bool first_row = true;
 	bool absolute_range;
 	XLSXCellType default_cell_type;
+
+	// Whether we are still looking for the first row with data, to determine the range
+	bool sniff_range;
+	// The cells of the current row, until the range is known
+	vector<XLSXCell> row_cells;
+	// The first consecutive non-empty cells of the current row
+	idx_t beg_col = 0;
+	idx_t end_col = 0;
+	enum class RangeState : uint8_t { EMPTY, FOUND, ENDED };
+	RangeState range_state = RangeState::EMPTY;
+	// The first row of the sheet, kept while sniffing the range in case no row has any data
+	bool has_first_row = false;
+	idx_t first_row_idx = 0;
+	vector<XLSXCell> first_row_cells;
+
+	idx_t sampled_row_size = 0;
+
+	// The data rows to sample to determine the column types
+	const XLSXStyleSheet &style_sheet;
+	bool all_varchar;
+	idx_t sample_size;
+	bool stop_at_empty;
+	idx_t sampled_rows = 0;
+	// The sniffed types, and whether a non-empty cell was sampled in the column
+	vector<LogicalType> column_types;
+	vector<XLSXCellType> source_types;
+	vector<bool> has_sample;
 };
 
+// Widen the type sniffed for a column so that it also fits another cell of the column
+inline LogicalType WidenSniffedType(const LogicalType &type, const XLSXCellType source, const LogicalType &other,
+                                   const XLSXCellType other_source) {
+	const auto is_date = [](const LogicalType &t) {
+		return t.id() == LogicalTypeId::DATE || t.id() == LogicalTypeId::TIMESTAMP;
+	};
+	const auto is_serial = [&](const LogicalType &t) {
+		return is_date(t) || t.id() == LogicalTypeId::TIME || t.id() == LogicalTypeId::DOUBLE;
+	};
+	// Dates are only read the same way if they come from the same kind of cell (serial numbers or ISO strings)
+	if (type == other && (source == other_source || !is_serial(type))) {
+		return type;
+	}
+	// Numbers are read as doubles, dates, times or timestamps depending on their style. Dates and timestamps can
+	// both be read as timestamps, any other mix of them only as the serial numbers.
+	if (source == XLSXCellType::NUMBER && other_source == XLSXCellType::NUMBER) {
+		if (is_date(type) && is_date(other)) {
+			return LogicalType::TIMESTAMP;
+		}
+		if (is_serial(type) && is_serial(other)) {
+			return LogicalType::DOUBLE;
+		}
+	}
+	return LogicalType::VARCHAR;
+}
+
 inline void HeaderSniffer::OnBeginRow(const idx_t row_idx) {
+	if (sniff_range) {
+		row_cells.clear();
+		range_state = RangeState::EMPTY;
+		beg_col = 0;
+		end_col = 0;
+		return;
+	}
 	if (!range.ContainsRow(row_idx)) {
 		return;
 	}
@@ -262,10 +1131,17 @@ inline void HeaderSniffer::OnBeginRow(const idx_t row_idx) {
 }
 
 inline void HeaderSniffer::OnCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style) {
+	if (sniff_range) {
+		SniffRangeCell(pos, type, data, style);
+		return;
+	}
 	if (!range.ContainsCol(pos.col)) {
 		return;
 	}
+	AddCell(type, pos, string(data.data(), data.size()), style);
+}
 
+inline void HeaderSniffer::AddCell(XLSXCellType type, const XLSXCellPos &pos, string data, idx_t style) {
 	// Now, add the cell to the data cells, but make sure to pad with empty varchars if needed.
 	if (last_col + 1 < pos.col) {
 		// Pad with empty cells
@@ -275,16 +1151,108 @@ inline void HeaderSniffer::OnCell(const XLSXCellPos &pos, XLSXCellType type, vec
 	}
 
 	// Add the cell
-	column_cells.emplace_back(type, pos, string(data.data(), data.size()), style);
+	column_cells.emplace_back(type, pos, std::move(data), style);
 	last_col = pos.col;
 }
 
+inline void HeaderSniffer::SniffRangeCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data,
+                                          idx_t style) {
+	switch (range_state) {
+	case RangeState::EMPTY:
+		if (!data.empty()) {
+			range_state = RangeState::FOUND;
+			beg_col = pos.col;
+			end_col = pos.col;
+		}
+		break;
+	case RangeState::FOUND:
+		if (data.empty()) {
+			range_state = RangeState::ENDED;
+		} else {
+			end_col = pos.col;
+		}
+		break;
+	case RangeState::ENDED:
+		// The columns are known, but we still need the cells in case this is the header row
+		break;
+	}
+	row_cells.emplace_back(type, pos, string(data.data(), data.size()), style);
+}
+
+inline void HeaderSniffer::SniffRangeEndRow(const idx_t row_idx) {
+	if (range_state == RangeState::EMPTY) {
+		if (!has_first_row) {
+			has_first_row = true;
+			first_row_idx = row_idx;
+			first_row_cells = std::move(row_cells);
+		}
+		// Continue on to the next row
+		return;
+	}
+
+	// We found a row with data, between beg_col and end_col. This is the range of the sheet.
+	range = XLSXCellRange(row_idx, beg_col, NumericLimits<idx_t>::Maximum(), end_col + 1);
+	sniff_range = false;
+
+	// Now inspect the row as if the range had been known all along
+	OnBeginRow(row_idx);
+	for (auto &cell : row_cells) {
+		if (range.ContainsCol(cell.cell.col)) {
+			AddCell(cell.type, cell.cell, std::move(cell.data), cell.style);
+		}
+	}
+	row_cells.clear();
+	OnEndRow(row_idx);
+}
+
+inline void HeaderSniffer::UseFirstRow() {
+	D_ASSERT(sniff_range);
+	sniff_range = false;
+	range = XLSXCellRange();
+
+	// The first row might hold empty cells in all columns, so only take the columns the dimension says are in use.
+	// Producers don't always get the dimension right, so only if it covers the cells of the row.
+	if (HasDimension()) {
+		const auto &dim = GetDimension();
+		auto is_valid = dim.IsValid();
+		for (auto &cell : first_row_cells) {
+			is_valid = is_valid && cell.cell.col <= dim.end.col;
+		}
+		if (is_valid) {
+			range.end.col = MinValue(dim.end.col + 1, range.end.col);
+		}
+	}
+	if (!has_first_row) {
+		return;
+	}
+
+	// Now inspect the row as if the range had been known all along
+	OnBeginRow(first_row_idx);
+	for (auto &cell : first_row_cells) {
+		if (range.ContainsCol(cell.cell.col)) {
+			AddCell(cell.type, cell.cell, std::move(cell.data), cell.style);
+		}
+	}
+	first_row_cells.clear();
+	OnEndRow(first_row_idx);
+}
+
 inline void HeaderSniffer::OnEndRow(const idx_t row_idx) {
+	if (sniff_range) {
+		SniffRangeEndRow(row_idx);
+		return;
+	}
 	if (!range.ContainsRow(row_idx)) {
 		column_cells.clear();
 		last_col = range.beg.col - 1;
+		if (row_idx >= range.end.row) {
+			// There are no more rows to sniff
+			Stop(false);
+		}
 		return;
 	}
+	// Unless this turns out to be the header, this is the first data row
+	sampled_row_size = GetRowSize();
 
 	// If there are columns missing at the end, pad with empty string cells
 	if (last_col + 1 < range.end.col) {
@@ -295,8 +1263,8 @@ inline void HeaderSniffer::OnEndRow(const idx_t row_idx) {
 
 	// Now we have all the cells in the row, we can inspect them
 	if (!first_row) {
-		// This is the data row. We can stop here
-		Stop(false);
+		// This is a data row
+		SampleDataRow();
 		return;
 	}
 
@@ -340,7 +1308,8 @@ inline void HeaderSniffer::OnEndRow(const idx_t row_idx) {
 				cell.data = cell.cell.GetColumnName();
 			}
 		}
-		Stop(false);
+		first_row = false;
+		SampleDataRow();
 		return;
 	}
 
@@ -356,52 +1325,309 @@ inline void HeaderSniffer::OnEndRow(const idx_t row_idx) {
 	range.beg.row = row_idx + 1;
 }
 
+inline void HeaderSniffer::SampleDataRow() {
+	auto is_empty = true;
+	for (const auto &cell : column_cells) {
+		is_empty = is_empty && cell.data.empty();
+	}
+	if (sampled_rows > 0 && is_empty && stop_at_empty) {
+		// The scan stops here, so the rows after it don't matter
+		Stop(false);
+		return;
+	}
+
+	if (sampled_rows == 0) {
+		// The first data row determines the types, unless its cells are empty
+		for (auto &cell : column_cells) {
+			column_types.push_back(cell.GetDuckDBType(all_varchar, style_sheet));
+			source_types.push_back(cell.type);
+			has_sample.push_back(!cell.data.empty());
+		}
+	} else if (!all_varchar) {
+		D_ASSERT(column_cells.size() == column_types.size());
+		for (idx_t col_idx = 0; col_idx < column_cells.size(); col_idx++) {
+			auto &cell = column_cells[col_idx];
+			if (cell.data.empty()) {
+				continue;
+			}
+			auto type = cell.GetDuckDBType(all_varchar, style_sheet);
+			if (has_sample[col_idx]) {
+				type = WidenSniffedType(column_types[col_idx], source_types[col_idx], type, cell.type);
+			} else {
+				source_types[col_idx] = cell.type;
+				has_sample[col_idx] = true;
+			}
+			column_types[col_idx] = std::move(type);
+		}
+	}
+
+	sampled_rows++;
+	if (sampled_rows >= sample_size || all_varchar) {
+		Stop(false);
+	}
+}
+
+//-------------------------------------------------------------------
+// Cell Decoding
+//-------------------------------------------------------------------
+// Excel writes numbers in a small subset of the usual grammar: an
+// optional minus, digits, an optional fraction and exponent. Most of
+// them can be converted exactly with a single multiplication or
+// division (Clinger's fast path), anything else is left to the casts
+// of DuckDB.
+//-------------------------------------------------------------------
+static constexpr double XLSX_POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+inline bool TryParseExcelNumber(const char *ptr, const idx_t len, double &result) {
+	static constexpr auto MAX_MANTISSA = (NumericLimits<uint64_t>::Maximum() - 9) / 10;
+	static constexpr auto MAX_EXACT_MANTISSA = uint64_t(1) << 53;
+
+	const auto end = ptr + len;
+	const auto negative = ptr < end && *ptr == '-';
+	ptr += negative;
+
+	// Digits, with an optional fraction
+	uint64_t mantissa = 0;
+	int64_t exponent = 0;
+	const auto int_beg = ptr;
+	for (; ptr < end && StringUtil::CharacterIsDigit(*ptr); ptr++) {
+		if (mantissa > MAX_MANTISSA) {
+			return false;
+		}
+		mantissa = mantissa * 10 + static_cast<uint64_t>(*ptr - '0');
+	}
+	if (ptr == int_beg) {
+		return false;
+	}
+	if (ptr < end && *ptr == '.') {
+		const auto frac_beg = ++ptr;
+		for (; ptr < end && StringUtil::CharacterIsDigit(*ptr); ptr++) {
+			if (mantissa > MAX_MANTISSA) {
+				return false;
+			}
+			mantissa = mantissa * 10 + static_cast<uint64_t>(*ptr - '0');
+			exponent--;
+		}
+		if (ptr == frac_beg) {
+			return false;
+		}
+	}
+
+	// Optional exponent
+	if (ptr < end && (*ptr == 'E' || *ptr == 'e')) {
+		ptr++;
+		const auto exp_negative = ptr < end && *ptr == '-';
+		ptr += ptr < end && (*ptr == '-' || *ptr == '+');
+		const auto exp_beg = ptr;
+		int64_t exp_value = 0;
+		for (; ptr < end && StringUtil::CharacterIsDigit(*ptr) && ptr - exp_beg < 4; ptr++) {
+			exp_value = exp_value * 10 + (*ptr - '0');
+		}
+		if (ptr == exp_beg) {
+			return false;
+		}
+		exponent += exp_negative ? -exp_value : exp_value;
+	}
+	if (ptr != end) {
+		return false;
+	}
+
+	// Both the mantissa and the power of ten are exact doubles, so the result is correctly rounded
+	if (mantissa > MAX_EXACT_MANTISSA || exponent < -22 || exponent > 22) {
+		return false;
+	}
+	auto value = static_cast<double>(mantissa);
+	value = exponent < 0 ? value / XLSX_POWERS_OF_TEN[-exponent] : value * XLSX_POWERS_OF_TEN[exponent];
+	result = negative ? -value : value;
+	return true;
+}
+
+inline bool TryParseExcelInteger(const char *ptr, const idx_t len, int64_t &result) {
+	const auto end = ptr + len;
+	const auto negative = ptr < end && *ptr == '-';
+	ptr += negative;
+	// Anything longer than 18 digits might not fit
+	if (ptr == end || end - ptr > 18) {
+		return false;
+	}
+	int64_t value = 0;
+	for (; ptr < end; ptr++) {
+		if (!StringUtil::CharacterIsDigit(*ptr)) {
+			return false;
+		}
+		value = value * 10 + (*ptr - '0');
+	}
+	result = negative ? -value : value;
+	return true;
+}
+
+// Convert an excel serial number (days since 1900-01-01) to microseconds since the epoch
+inline int64_t ExcelToEpochUS(const double serial) {
+	// Convert to microseconds since epoch
+	static constexpr auto SECONDS_PER_DAY = 86400UL;
+	static constexpr auto MICROSECONDS_PER_SECOND = 1000000UL;
+	static constexpr auto DAYS_BETWEEN_1900_AND_1970 = 25569UL;
+
+	// Excel serial is days since 1900-01-01
+	const auto serial_days = serial;
+	auto serial_secs = serial_days * SECONDS_PER_DAY;
+
+	if (std::fabs(serial_secs - std::round(serial_secs)) < 1e-3) {
+		serial_secs = std::round(serial_secs);
+	}
+
+	const auto epoch_secs = serial_secs - (DAYS_BETWEEN_1900_AND_1970 * SECONDS_PER_DAY);
+	const auto epoch_micros = epoch_secs * MICROSECONDS_PER_SECOND;
+
+	// Clamp to the range. Theres not much we can do if the value is out of range
+	if (epoch_micros <= static_cast<double>(NumericLimits<int64_t>::Minimum())) {
+		return NumericLimits<int64_t>::Minimum();
+	}
+	if (epoch_micros >= static_cast<double>(NumericLimits<int64_t>::Maximum())) {
+		return NumericLimits<int64_t>::Maximum();
+	}
+
+	return static_cast<int64_t>(epoch_micros);
+}
+
+inline date_t ExcelToDate(const double serial) {
+	// Whole days (by far the most common) don't need to go through a timestamp
+	if (std::fabs(serial) < 1e7 && std::trunc(serial) == serial) {
+		return date_t(static_cast<int32_t>(serial) - 25569);
+	}
+	return Timestamp::GetDate(Timestamp::FromEpochMicroSeconds(ExcelToEpochUS(serial)));
+}
+
 //-------------------------------------------------------------------
 // Sheet Parser
 //-------------------------------------------------------------------
-// The sheet parser is used to parse the actual data from the sheet
+// The sheet parser is used to parse the actual data from the sheet.
+// Only the given columns of the range are read into the chunk, the
+// data of all other cells is skipped. Numbers, booleans and dates are
+// decoded directly into vectors of their type, all other columns are
+// read as strings and cast afterwards.
 //-------------------------------------------------------------------
+
+// A column of the range to read
+struct XLSXReadColumn {
+	// The column, relative to the beginning of the range
+	idx_t col;
+	// The type to read the column as
+	LogicalType type;
+	// The sniffed cell type of the column
+	XLSXCellType cell_type;
+};
+
+// What a sheet parser did so far, for profiling
+struct SheetParserStats {
+	// The rows and cells reported by the tokenizer (or expat), in the range or not
+	idx_t xml_events = 0;
+	// The cells in the range that were parsed into the chunk
+	idx_t cells_parsed = 0;
+	// The NULL cells of the rows padded by SkipRows() and FillRows()
+	idx_t cells_padded = 0;
+	// The bytes of the shared strings the parsed cells refer to
+	idx_t shared_string_bytes = 0;
+};
+
 class SheetParser final : public SheetParserBase {
 public:
 	explicit SheetParser(ClientContext &context, const XLSXCellRange &range_p, const StringTable &table,
-	                     bool stop_at_empty_p)
-	    : string_table(table), range(range_p), stop_at_empty(stop_at_empty_p) {
+	                     bool stop_at_empty_p, bool ignore_errors_p, const vector<XLSXReadColumn> &read_columns)
+	    : string_table(table), range(range_p), stop_at_empty(stop_at_empty_p), ignore_errors(ignore_errors_p) {
+
+		// Initialize the chunk, with a vector for every column we read
+		vector<LogicalType> types;
+		for (auto &column : read_columns) {
+			const auto decoder = GetDecoder(column);
+			columns.push_back(column.col);
+			decoders.push_back(decoder);
+			types.push_back(decoder == CellDecoder::VARCHAR ? LogicalType::VARCHAR : column.type);
+		}
+		if (!types.empty()) {
+			auto &buffer_alloc = BufferAllocator::Get(context);
+			chunk.Initialize(buffer_alloc, types);
+		}
 
-		// Initialize the chunk
-		const vector<LogicalType> types(range.Width(), LogicalType::VARCHAR);
-		auto &buffer_alloc = BufferAllocator::Get(context);
-		chunk.Initialize(buffer_alloc, types);
+		// Map the columns of the range to the columns of the chunk, and only capture the cells we read
+		column_map = make_unsafe_uniq_array<idx_t>(range.Width());
+		std::fill_n(column_map.get(), range.Width(), DConstants::INVALID_INDEX);
+		vector<bool> captured(range.end.col, false);
+		for (idx_t chunk_col = 0; chunk_col < columns.size(); chunk_col++) {
+			D_ASSERT(columns[chunk_col] < range.Width());
+			D_ASSERT(chunk_col == 0 || columns[chunk_col - 1] < columns[chunk_col]);
+			column_map[columns[chunk_col]] = chunk_col;
+			captured[range.beg.col + columns[chunk_col]] = true;
+		}
+		SetCapturedColumns(std::move(captured));
+		SetSkippedRows(range.beg.row);
 
-		// Set the beginning column
 		// Allocate the sheet row number mapping
 		sheet_row_number = make_unsafe_uniq_array<idx_t>(STANDARD_VECTOR_SIZE);
 
 		last_row = range.beg.row - 1;
 		curr_row = range.beg.row;
-		last_col = range.beg.col - 1;
 	}
 
 	DataChunk &GetChunk() {
 		return chunk;
 	}
+	// The columns of the range that are read, one for each column in the chunk
+	const vector<idx_t> &GetColumns() const {
+		return columns;
+	}
 	string GetCellName(idx_t chunk_row, idx_t chunk_col) const;
+	// The (1-indexed) sheet row of a row in the chunk
+	idx_t GetSheetRow(idx_t chunk_row) const {
+		return sheet_row_number[chunk_row];
+	}
 
 	// Returns true if the chunk is full
 	bool FoundSkippedRow() const;
+	// Whether the parser stopped at an empty row (only when stopping at empty rows)
+	bool FoundEmptyRow() const {
+		return found_empty_row;
+	}
+	// The last row of the range that was parsed (or padded)
+	idx_t GetLastRow() const {
+		return last_row;
+	}
 	void SkipRows();
 	// Fill empty rows to the end of the range
 	void FillRows();
 
+	const SheetParserStats &GetStats() const {
+		return stats;
+	}
+
 protected:
 	void OnBeginRow(idx_t row_idx) override;
 	void OnEndRow(idx_t row_idx) override;
 	void OnCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style) override;
+	void OnNumberCell(const XLSXCellPos &pos, XLSXCellType type, double number, idx_t style) override;
+	void OnSkippedCell(const XLSXCellPos &pos, bool has_data) override;
+
+private:
+	// How the cells of a column are decoded. Serial dates and times are stored as numbers.
+	enum class CellDecoder : uint8_t { VARCHAR, DOUBLE, BIGINT, BOOLEAN, SERIAL_DATE, SERIAL_TIME, SERIAL_TIMESTAMP };
+	static CellDecoder GetDecoder(const XLSXReadColumn &column);
+
+	bool TryBeginCell(const XLSXCellPos &pos, idx_t &chunk_col);
+	void DecodeCell(Vector &vec, idx_t chunk_col, const XLSXCellPos &pos, const string_t &text);
+	void DecodeNumber(Vector &vec, idx_t chunk_col, const XLSXCellPos &pos, double number);
+	void OnDecodeError(Vector &vec, const XLSXCellPos &pos, const string_t &text, const LogicalType &type) const;
 
 private:
 	// Shared String Table
 	const StringTable &string_table;
 	// Range to read
 	XLSXCellRange range;
+	// Columns of the range to read, and the chunk column of every column in the range
+	vector<idx_t> columns;
+	vector<CellDecoder> decoders;
+	unsafe_unique_array<idx_t> column_map;
 	// Mapping from chunk row to sheet row
 	unsafe_unique_array<idx_t> sheet_row_number;
 	// Current chunk
@@ -409,20 +1635,48 @@ private:
 	// Current row in the chunk
 	idx_t out_index = 0;
 
-	// The last column we wrote to
-	idx_t last_col;
+	// The next chunk column to write to
+	idx_t next_col = 0;
 	// The last row we wrote to
 	idx_t last_row;
 	idx_t curr_row;
 
 	bool stop_at_empty = false;
 	bool is_row_empty = false;
+	bool found_empty_row = false;
+	// Whether to read cells that can't be decoded as NULL, instead of throwing
+	bool ignore_errors = false;
+	// The text of a number of a binary sheet, only formatted for VARCHAR columns and errors
+	vector<char> number_text;
+
+	SheetParserStats stats;
 };
 
+inline SheetParser::CellDecoder SheetParser::GetDecoder(const XLSXReadColumn &column) {
+	const auto is_number = column.cell_type == XLSXCellType::NUMBER;
+	switch (column.type.id()) {
+	case LogicalTypeId::DOUBLE:
+		return CellDecoder::DOUBLE;
+	case LogicalTypeId::BIGINT:
+		return CellDecoder::BIGINT;
+	case LogicalTypeId::BOOLEAN:
+		return CellDecoder::BOOLEAN;
+	case LogicalTypeId::DATE:
+		return is_number ? CellDecoder::SERIAL_DATE : CellDecoder::VARCHAR;
+	case LogicalTypeId::TIME:
+		return is_number ? CellDecoder::SERIAL_TIME : CellDecoder::VARCHAR;
+	case LogicalTypeId::TIMESTAMP:
+		return is_number ? CellDecoder::SERIAL_TIMESTAMP : CellDecoder::VARCHAR;
+	default:
+		// Read as string and cast later
+		return CellDecoder::VARCHAR;
+	}
+}
+
 inline string SheetParser::GetCellName(idx_t chunk_row, idx_t chunk_col) const {
 	// Get the cell name and row given a chunk row and column
 	const auto sheet_row = sheet_row_number[chunk_row];
-	const auto sheet_col = chunk_col + range.beg.col;
+	const auto sheet_col = columns[chunk_col] + range.beg.col;
 
 	const XLSXCellPos pos = {static_cast<idx_t>(sheet_row), sheet_col};
 	return pos.ToString();
@@ -440,6 +1694,7 @@ inline void SheetParser::SkipRows() {
 		for (auto &col : chunk.data) {
 			FlatVector::SetNull(col, out_index, true);
 		}
+		stats.cells_padded += chunk.data.size();
 		sheet_row_number[out_index] = last_row;
 		out_index++;
 		chunk.SetCardinality(out_index);
@@ -463,24 +1718,31 @@ inline void SheetParser::FillRows() {
 
 	const auto remaining = MinValue(total_remaining, local_remaining);
 	for (idx_t i = 0; i < remaining; i++) {
+		last_row++;
 		for (auto &col : chunk.data) {
 			FlatVector::SetNull(col, out_index, true);
 		}
 		sheet_row_number[out_index] = last_row;
 		out_index++;
-		last_row++;
 	}
+	stats.cells_padded += remaining * chunk.data.size();
 	chunk.SetCardinality(chunk.size() + remaining);
 	out_index = 0;
 }
 
 inline void SheetParser::OnBeginRow(idx_t row_idx) {
+	stats.xml_events++;
+	if (row_idx >= range.end.row) {
+		// The rows are in order, so none of the remaining rows are in range
+		Stop(false);
+		return;
+	}
 	if (!range.ContainsRow(row_idx)) {
 		// not in range, skip
 		return;
 	}
 
-	last_col = range.beg.col - 1;
+	next_col = 0;
 	is_row_empty = true;
 
 	curr_row = row_idx;
@@ -491,50 +1753,225 @@ inline void SheetParser::OnBeginRow(idx_t row_idx) {
 	}
 }
 
-inline void SheetParser::OnCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style) {
+// Start parsing a cell into the chunk, padding the columns skipped before it. Returns false if it is not in the range.
+inline bool SheetParser::TryBeginCell(const XLSXCellPos &pos, idx_t &chunk_col) {
+	stats.xml_events++;
 	if (!range.ContainsPos(pos)) {
 		// not in range, skip
-		return;
+		return false;
 	}
+	stats.cells_parsed++;
 
 	// If we jumped over some columns, pad with nulls
-	if (last_col + 1 < pos.col) {
-		for (idx_t i = last_col + 1; i < pos.col; i++) {
-			auto &vec = chunk.data[i - range.beg.col];
+	chunk_col = column_map[pos.col - range.beg.col];
+	for (; next_col < chunk_col; next_col++) {
+		FlatVector::SetNull(chunk.data[next_col], out_index, true);
+	}
+	return true;
+}
+
+inline void SheetParser::OnCell(const XLSXCellPos &pos, XLSXCellType type, vector<char> &data, idx_t style) {
+	idx_t chunk_col;
+	if (!TryBeginCell(pos, chunk_col)) {
+		return;
+	}
+
+	// Get the column data
+	auto &vec = chunk.data[chunk_col];
+
+	if (decoders[chunk_col] != CellDecoder::VARCHAR) {
+		// Decode the cell straight into the typed vector
+		string_t text;
+		if (type == XLSXCellType::SHARED_STRING) {
+			data.push_back('\0');
+			text = string_table.Get(std::strtol(data.data(), nullptr, 10));
+			stats.shared_string_bytes += text.GetSize();
+		} else {
+			text = string_t(data.data(), UnsafeNumericCast<uint32_t>(data.size()));
+		}
+		if (text.Empty()) {
+			// Empty cells can't be converted, so they are NULL
+			FlatVector::SetNull(vec, out_index, true);
+		} else {
+			DecodeCell(vec, chunk_col, pos, text);
+		}
+	} else {
+		// Push the cell data to our chunk
+		const auto ptr = FlatVector::GetData<string_t>(vec);
+
+		if (type == XLSXCellType::SHARED_STRING) {
+			// Push a null to the buffer so that the string is null-terminated
+			data.push_back('\0');
+			// Now we can use strtol to get the shared string index
+			const auto ssi = std::strtol(data.data(), nullptr, 10);
+			// Look up the string in the string table
+			ptr[out_index] = string_table.Get(ssi);
+			stats.shared_string_bytes += ptr[out_index].GetSize();
+		} else if (data.empty() && type != XLSXCellType::INLINE_STRING) {
+			// If the cell is empty (and not a string), we wont be able to convert it
+			// so just null it immediately
 			FlatVector::SetNull(vec, out_index, true);
+		} else {
+			// Otherwise just pass along the call data, we will cast it later.
+			ptr[out_index] = StringVector::AddString(vec, data.data(), data.size());
 		}
 	}
 
-	// Get the column data
-	auto &vec = chunk.data[pos.col - range.beg.col];
+	if (!data.empty()) {
+		is_row_empty = false;
+	}
 
-	// Push the cell data to our chunk
-	const auto ptr = FlatVector::GetData<string_t>(vec);
+	next_col = chunk_col + 1;
+}
+
+inline void SheetParser::OnNumberCell(const XLSXCellPos &pos, XLSXCellType type, double number, idx_t style) {
+	idx_t chunk_col;
+	if (!TryBeginCell(pos, chunk_col)) {
+		return;
+	}
 
+	auto &vec = chunk.data[chunk_col];
 	if (type == XLSXCellType::SHARED_STRING) {
-		// Push a null to the buffer so that the string is null-terminated
-		data.push_back('\0');
-		// Now we can use strtol to get the shared string index
-		const auto ssi = std::strtol(data.data(), nullptr, 10);
-		// Look up the string in the string table
-		ptr[out_index] = string_table.Get(ssi);
-	} else if (data.empty() && type != XLSXCellType::INLINE_STRING) {
-		// If the cell is empty (and not a string), we wont be able to convert it
-		// so just null it immediately
-		FlatVector::SetNull(vec, out_index, true);
+		const auto &text = string_table.Get(static_cast<idx_t>(number));
+		stats.shared_string_bytes += text.GetSize();
+		if (decoders[chunk_col] == CellDecoder::VARCHAR) {
+			FlatVector::GetData<string_t>(vec)[out_index] = text;
+		} else if (text.Empty()) {
+			FlatVector::SetNull(vec, out_index, true);
+		} else {
+			DecodeCell(vec, chunk_col, pos, text);
+		}
 	} else {
-		// Otherwise just pass along the call data, we will cast it later.
-		ptr[out_index] = StringVector::AddString(vec, data.data(), data.size());
+		DecodeNumber(vec, chunk_col, pos, number);
 	}
 
-	if (!data.empty()) {
-		is_row_empty = false;
+	is_row_empty = false;
+	next_col = chunk_col + 1;
+}
+
+inline void SheetParser::DecodeCell(Vector &vec, const idx_t chunk_col, const XLSXCellPos &pos,
+                                    const string_t &text) {
+	const auto ptr = text.GetData();
+	const auto len = text.GetSize();
+
+	// Try the excel number format first, and fall back to a regular cast
+	double number;
+	switch (decoders[chunk_col]) {
+	case CellDecoder::DOUBLE:
+		if (TryParseExcelNumber(ptr, len, number) || TryCast::Operation(text, number)) {
+			FlatVector::GetData<double>(vec)[out_index] = number;
+			return;
+		}
+		break;
+	case CellDecoder::BIGINT: {
+		int64_t integer;
+		if (TryParseExcelInteger(ptr, len, integer) || TryCast::Operation(text, integer)) {
+			FlatVector::GetData<int64_t>(vec)[out_index] = integer;
+			return;
+		}
+		break;
+	}
+	case CellDecoder::BOOLEAN: {
+		bool boolean;
+		if (TryCast::Operation(text, boolean)) {
+			FlatVector::GetData<bool>(vec)[out_index] = boolean;
+			return;
+		}
+		break;
 	}
+	case CellDecoder::SERIAL_DATE:
+	case CellDecoder::SERIAL_TIME:
+	case CellDecoder::SERIAL_TIMESTAMP:
+		if (!TryParseExcelNumber(ptr, len, number) && !TryCast::Operation(text, number)) {
+			// The serial number itself is invalid
+			OnDecodeError(vec, pos, text, LogicalType::DOUBLE);
+			return;
+		}
+		if (decoders[chunk_col] == CellDecoder::SERIAL_DATE) {
+			FlatVector::GetData<date_t>(vec)[out_index] = ExcelToDate(number);
+		} else if (decoders[chunk_col] == CellDecoder::SERIAL_TIME) {
+			const auto stamp = Timestamp::FromEpochMicroSeconds(ExcelToEpochUS(number));
+			FlatVector::GetData<dtime_t>(vec)[out_index] = Timestamp::GetTime(stamp);
+		} else {
+			FlatVector::GetData<timestamp_t>(vec)[out_index] = Timestamp::FromEpochMicroSeconds(ExcelToEpochUS(number));
+		}
+		return;
+	default:
+		throw InternalException("Unexpected cell decoder");
+	}
+	OnDecodeError(vec, pos, text, vec.GetType());
+}
 
-	last_col = pos.col;
+// Write a number (or boolean) of a binary sheet straight into the typed vector, only VARCHAR columns need its text
+inline void SheetParser::DecodeNumber(Vector &vec, const idx_t chunk_col, const XLSXCellPos &pos, const double number) {
+	switch (decoders[chunk_col]) {
+	case CellDecoder::DOUBLE:
+		FlatVector::GetData<double>(vec)[out_index] = number;
+		return;
+	case CellDecoder::BIGINT:
+		if (std::trunc(number) == number && number >= -9223372036854775808.0 && number < 9223372036854775808.0) {
+			FlatVector::GetData<int64_t>(vec)[out_index] = static_cast<int64_t>(number);
+			return;
+		}
+		break;
+	case CellDecoder::BOOLEAN:
+		// Like the text "0" or "1" of the cell in XML
+		if (number == 0 || number == 1) {
+			FlatVector::GetData<bool>(vec)[out_index] = number == 1;
+			return;
+		}
+		break;
+	case CellDecoder::SERIAL_DATE:
+		FlatVector::GetData<date_t>(vec)[out_index] = ExcelToDate(number);
+		return;
+	case CellDecoder::SERIAL_TIME: {
+		const auto stamp = Timestamp::FromEpochMicroSeconds(ExcelToEpochUS(number));
+		FlatVector::GetData<dtime_t>(vec)[out_index] = Timestamp::GetTime(stamp);
+		return;
+	}
+	case CellDecoder::SERIAL_TIMESTAMP:
+		FlatVector::GetData<timestamp_t>(vec)[out_index] = Timestamp::FromEpochMicroSeconds(ExcelToEpochUS(number));
+		return;
+	case CellDecoder::VARCHAR:
+		break;
+	default:
+		throw InternalException("Unexpected cell decoder");
+	}
+
+	// The text of the cell, either as the value or to report the error
+	number_text.clear();
+	AppendXLSBNumber(number, number_text);
+	const auto text = string_t(number_text.data(), UnsafeNumericCast<uint32_t>(number_text.size()));
+	if (decoders[chunk_col] == CellDecoder::VARCHAR) {
+		FlatVector::GetData<string_t>(vec)[out_index] = StringVector::AddString(vec, text);
+		return;
+	}
+	OnDecodeError(vec, pos, text, vec.GetType());
+}
+
+inline void SheetParser::OnDecodeError(Vector &vec, const XLSXCellPos &pos, const string_t &text,
+                                       const LogicalType &type) const {
+	FlatVector::SetNull(vec, out_index, true);
+	if (ignore_errors) {
+		return;
+	}
+	// Cast the value again to report the same error as a regular cast would
+	Value result;
+	string error;
+	Value(text.GetString()).DefaultTryCastAs(type, result, &error);
+	throw InvalidInputException("read_xlsx: Failed to parse cell '%s': %s", pos.ToString(), error);
+}
+
+inline void SheetParser::OnSkippedCell(const XLSXCellPos &pos, bool has_data) {
+	stats.xml_events++;
+	// We don't read this cell, but it still counts towards the row being empty
+	if (has_data && range.ContainsPos(pos)) {
+		is_row_empty = false;
+	}
 }
 
 inline void SheetParser::OnEndRow(idx_t row_idx) {
+	stats.xml_events++;
 	if (!range.ContainsRow(row_idx)) {
 		// not in range, skip
 		return;
@@ -543,16 +1980,14 @@ inline void SheetParser::OnEndRow(idx_t row_idx) {
 	last_row = row_idx;
 
 	if (stop_at_empty && is_row_empty) {
+		found_empty_row = true;
 		Stop(false);
 		return;
 	}
 
 	// If we didnt write out all the columns, pad with nulls
-	if (last_col + 1 < range.end.col) {
-		for (idx_t i = last_col + 1; i < range.end.col; i++) {
-			auto &vec = chunk.data[i - range.beg.col];
-			FlatVector::SetNull(vec, out_index, true);
-		}
+	for (; next_col < columns.size(); next_col++) {
+		FlatVector::SetNull(chunk.data[next_col], out_index, true);
 	}
 
 	// Map the chunk row to the sheet row
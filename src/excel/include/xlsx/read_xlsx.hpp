@@ -1,5 +1,6 @@
 #pragma once
 #include "duckdb/function/table_function.hpp"
+#include "duckdb/common/multi_file/multi_file_reader.hpp"
 #include "duckdb/common/named_parameter_map.hpp"
 
 #include "xlsx/xlsx_parts.hpp"
@@ -12,11 +13,16 @@ struct WriteXLSX {
 	static void Register(ExtensionLoader &loader);
 };
 
+struct GenerateXLSX {
+	static void Register(ExtensionLoader &loader);
+};
+
 enum class XLSXHeaderMode : uint8_t { NEVER, MAYBE, FORCE };
 
 class XLSXReadOptions {
 public:
-	string sheet;
+	// The sheets to read, either names or patterns. Defaults to the first sheet of the workbook.
+	vector<string> sheets;
 	XLSXHeaderMode header_mode = XLSXHeaderMode::MAYBE;
 	bool all_varchar = false;
 	bool ignore_errors = false;
@@ -25,10 +31,45 @@ public:
 	bool normalize_names = false;
 	XLSXCellType default_cell_type = XLSXCellType::NUMBER;
 	XLSXCellRange range;
+	// The number of data rows to sniff the column types from
+	idx_t sample_size = 1;
+};
+
+// A sheet to scan
+class XLSXSheetSource {
+public:
+	XLSXSheetSource(idx_t file_idx_p, string sheet_name_p, string sheet_path_p)
+	    : file_idx(file_idx_p), sheet_name(std::move(sheet_name_p)), sheet_path(std::move(sheet_path_p)) {
+	}
+
+	// The file containing the sheet
+	idx_t file_idx;
+	// The name of the sheet in the workbook
+	string sheet_name;
+	// The path of the sheet in the archive
+	string sheet_path;
 };
 
+// The resolved layout of a sheet to scan
+class XLSXSheetLayout {
+public:
+	// The range of the data cells (header not included)
+	XLSXCellRange range;
+	// The excel cell types of the columns in the range
+	vector<XLSXCellType> source_types;
+	// Maps the columns in the range to the result columns
+	vector<idx_t> column_map;
+	// The uncompressed size of the sheet, used to estimate how many threads can scan it
+	idx_t sheet_size = 0;
+	// The estimated number of rows in the range, reported to the optimizer
+	optional_idx estimated_rows;
+};
+
+class XLSXOpenWorkbook;
+
 class XLSXReadData final : public TableFunctionData {
 public:
+	// The first file and sheet, the schema is sniffed from this sheet
 	string file_path;
 	string sheet_path;
 
@@ -38,17 +79,40 @@ public:
 
 	XLSXReadOptions options;
 	XLSXStyleSheet style_sheet;
-};
 
-class ZipFileReader;
+	// The files to scan are globbed and pruned by the multi file reader, which also handles the multi file options
+	// (union_by_name, filename, hive partitioning)
+	unique_ptr<MultiFileReader> multi_file_reader;
+	shared_ptr<MultiFileList> file_list;
+	MultiFileOptions file_options;
+	MultiFileReaderBindData reader_bind;
+
+	// All the files to scan
+	vector<string> files;
+	// All the sheets to scan, from all files
+	vector<XLSXSheetSource> sheets;
+	// Either a single layout shared by all sheets, or one layout per sheet (union_by_name)
+	vector<XLSXSheetLayout> layouts;
+	// The number of result columns that are read from the sheet, the rest are constant per file
+	idx_t sheet_column_count = 0;
+	// The values of the constant columns (filename, hive partitions) for each file
+	vector<vector<Value>> file_constants;
+	// The first file as opened during bind, handed over to the scan so that it doesn't have to be read again
+	shared_ptr<XLSXOpenWorkbook> open_workbook;
+
+public:
+	const XLSXSheetLayout &GetLayout(const idx_t sheet_idx) const {
+		return layouts.size() == 1 ? layouts[0] : layouts[sheet_idx];
+	}
+};
 
 struct ReadXLSX {
 	// options and file path need to be resolved already
 	static void ParseOptions(XLSXReadOptions &options, const named_parameter_map_t &input);
-	static void ResolveSheet(const unique_ptr<XLSXReadData> &result, ZipFileReader &archive);
+	static void ResolveSheet(ClientContext &context, const unique_ptr<XLSXReadData> &result);
 
 	static void Register(ExtensionLoader &loader);
 	static TableFunction GetFunction();
 };
 
-} // namespace duckdb
\ No newline at end of file
+} // namespace duckdb
@@ -18,6 +18,11 @@ public:
 	}
 	idx_t Add(const string_t &str);
 	const string_t &Get(idx_t val) const;
+	idx_t Size() const {
+		return index.size();
+	}
+	// Returns a rough estimate of the memory used by the table
+	idx_t GetMemoryUsage() const;
 	void Reserve(idx_t count);
 
 private:
@@ -63,6 +68,12 @@ inline const string_t &StringTable::Get(const idx_t val) const {
 	return index[val];
 }
 
+inline idx_t StringTable::GetMemoryUsage() const {
+	// Every unique string is in the map, and every string (including duplicates) in the index
+	const auto map_size = table.size() * (sizeof(string_t) + sizeof(idx_t) + sizeof(void *));
+	return arena.SizeInBytes() + map_size + index.capacity() * sizeof(string_t);
+}
+
 inline void StringTable::Reserve(const idx_t count) {
 	table.reserve(count);
 	index.reserve(count);
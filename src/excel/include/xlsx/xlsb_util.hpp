@@ -0,0 +1,297 @@
+#pragma once
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "xlsx/xml_util.hpp"
+#include "xlsx/zip_file.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace duckdb {
+
+//-------------------------------------------------------------------
+// XLSB Records
+//-------------------------------------------------------------------
+// Binary workbooks (.xlsb) are zip archives laid out like xlsx files,
+// but the workbook, sheets, shared strings and styles are streams of
+// BIFF12 records instead of XML. Every record starts with its type
+// (1-2 bytes) and the size of its data (1-4 bytes), both stored with
+// 7 bits per byte and the high bit set on all but the last byte. All
+// numbers in the data are little-endian. Only the records needed to
+// read the cells are decoded, all others are skipped by their size.
+//-------------------------------------------------------------------
+
+// Sheet records
+static constexpr uint32_t XLSB_ROW_HDR = 0;
+static constexpr uint32_t XLSB_CELL_BLANK = 1;
+static constexpr uint32_t XLSB_CELL_RK = 2;
+static constexpr uint32_t XLSB_CELL_ERROR = 3;
+static constexpr uint32_t XLSB_CELL_BOOL = 4;
+static constexpr uint32_t XLSB_CELL_REAL = 5;
+static constexpr uint32_t XLSB_CELL_ST = 6;
+static constexpr uint32_t XLSB_CELL_ISST = 7;
+static constexpr uint32_t XLSB_FMLA_STRING = 8;
+static constexpr uint32_t XLSB_FMLA_NUM = 9;
+static constexpr uint32_t XLSB_FMLA_BOOL = 10;
+static constexpr uint32_t XLSB_FMLA_ERROR = 11;
+// Cells without a column, which is the column after the previous cell
+static constexpr uint32_t XLSB_SHORT_BLANK = 12;
+static constexpr uint32_t XLSB_SHORT_RK = 13;
+static constexpr uint32_t XLSB_SHORT_ERROR = 14;
+static constexpr uint32_t XLSB_SHORT_BOOL = 15;
+static constexpr uint32_t XLSB_SHORT_REAL = 16;
+static constexpr uint32_t XLSB_SHORT_ST = 17;
+static constexpr uint32_t XLSB_SHORT_ISST = 18;
+static constexpr uint32_t XLSB_CELL_RSTRING = 62;
+static constexpr uint32_t XLSB_END_SHEET_DATA = 146;
+static constexpr uint32_t XLSB_WS_DIM = 148;
+
+// Shared string records
+static constexpr uint32_t XLSB_SST_ITEM = 19;
+static constexpr uint32_t XLSB_BEGIN_SST = 159;
+static constexpr uint32_t XLSB_END_SST = 160;
+
+// Workbook records
+static constexpr uint32_t XLSB_BUNDLE_SH = 156;
+
+// Style records
+static constexpr uint32_t XLSB_FMT = 44;
+static constexpr uint32_t XLSB_XF = 47;
+static constexpr uint32_t XLSB_BEGIN_CELL_XFS = 617;
+static constexpr uint32_t XLSB_END_CELL_XFS = 618;
+
+// Whether a part of the archive is a binary (record) part, which is the case for all parts of xlsb workbooks
+inline bool IsXLSBPart(const string &part_name) {
+	return StringUtil::EndsWith(part_name, ".bin");
+}
+
+// Try to read the type and size of the record at ptr, moving ptr past the header. Returns false (without moving ptr)
+// if the input ends before the header does.
+inline bool TryReadXLSBRecordHeader(const char *&ptr, const char *end, uint32_t &type, uint32_t &size) {
+	auto next = ptr;
+	type = 0;
+	for (idx_t i = 0;; i++) {
+		if (next == end) {
+			return false;
+		}
+		const auto byte = static_cast<uint8_t>(*next++);
+		type |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+		if (!(byte & 0x80)) {
+			break;
+		}
+		if (i == 1) {
+			throw InvalidInputException("XLSB: Invalid record type (is the file corrupted?)");
+		}
+	}
+	size = 0;
+	for (idx_t i = 0;; i++) {
+		if (next == end) {
+			return false;
+		}
+		const auto byte = static_cast<uint8_t>(*next++);
+		size |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+		if (!(byte & 0x80)) {
+			break;
+		}
+		if (i == 3) {
+			throw InvalidInputException("XLSB: Invalid record size (is the file corrupted?)");
+		}
+	}
+	ptr = next;
+	return true;
+}
+
+// Append an integer, formatted the way it would be written to the XML of a sheet
+inline void AppendXLSBInteger(const int64_t value, vector<char> &out) {
+	char buffer[24];
+	auto ptr = buffer + sizeof(buffer);
+	auto rest = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+	do {
+		*--ptr = static_cast<char>('0' + rest % 10);
+		rest /= 10;
+	} while (rest > 0);
+	if (value < 0) {
+		*--ptr = '-';
+	}
+	out.insert(out.end(), ptr, buffer + sizeof(buffer));
+}
+
+// Append a number as text, the way it would be written to the XML of a sheet: integers without a fraction, anything
+// else with as few digits as it takes to read back the same double. Only needed where the text of a cell is used,
+// the number is formatted by DuckDB so that it doesn't depend on the locale.
+inline void AppendXLSBNumber(const double value, vector<char> &out) {
+	if (std::fabs(value) < 1e15 && std::trunc(value) == value) {
+		AppendXLSBInteger(static_cast<int64_t>(value), out);
+		return;
+	}
+	const auto text = Value::DOUBLE(value).ToString();
+	out.insert(out.end(), text.begin(), text.end());
+}
+
+// Decode an RkNumber: a double with only the 30 most significant bits, or a 30-bit integer, optionally divided by 100
+inline double DecodeXLSBRkNumber(const uint32_t rk) {
+	double value;
+	if (rk & 0x02) {
+		value = static_cast<double>(static_cast<int32_t>(rk) >> 2);
+	} else {
+		const auto bits = static_cast<uint64_t>(rk & 0xFFFFFFFC) << 32;
+		memcpy(&value, &bits, sizeof(value));
+	}
+	return (rk & 0x01) ? value / 100 : value;
+}
+
+// The text excel shows for an error code
+inline const char *GetXLSBErrorText(const uint8_t code) {
+	switch (code) {
+	case 0x00:
+		return "#NULL!";
+	case 0x07:
+		return "#DIV/0!";
+	case 0x0F:
+		return "#VALUE!";
+	case 0x17:
+		return "#REF!";
+	case 0x1D:
+		return "#NAME?";
+	case 0x24:
+		return "#NUM!";
+	case 0x2A:
+		return "#N/A";
+	case 0x2B:
+		return "#GETTING_DATA";
+	default:
+		return "#ERROR!";
+	}
+}
+
+//-------------------------------------------------------------------
+// XLSB Record Reader
+//-------------------------------------------------------------------
+// Reads the fields of a single record, throwing if the record is too
+// short to hold them.
+//-------------------------------------------------------------------
+class XLSBRecordReader {
+public:
+	XLSBRecordReader(const char *data, const idx_t size) : ptr(data), end(data + size) {
+	}
+
+	uint8_t ReadByte() {
+		return Read<uint8_t>();
+	}
+	uint16_t ReadUInt16() {
+		return Read<uint16_t>();
+	}
+	uint32_t ReadUInt32() {
+		return Read<uint32_t>();
+	}
+	double ReadDouble() {
+		return Read<double>();
+	}
+	void Skip(const idx_t count) {
+		Require(count);
+		ptr += count;
+	}
+
+	// Read an XLWideString (a count of UTF-16 code units, and the code units) and append it as UTF-8
+	void ReadWideString(vector<char> &out) {
+		DecodeWideString(ReadUInt32(), out);
+	}
+	// Same as above, but the string is null if its count is 0xFFFFFFFF. Returns false if it is null.
+	bool ReadNullableWideString(vector<char> &out) {
+		const auto count = ReadUInt32();
+		if (count == 0xFFFFFFFF) {
+			return false;
+		}
+		DecodeWideString(count, out);
+		return true;
+	}
+	// Skip an XLWideString, returning its length
+	idx_t SkipWideString() {
+		const auto count = ReadUInt32();
+		Skip(idx_t(count) * 2);
+		return count;
+	}
+
+private:
+	void Require(const idx_t count) const {
+		if (static_cast<idx_t>(end - ptr) < count) {
+			throw InvalidInputException("XLSB: Record too short (is the file corrupted?)");
+		}
+	}
+	template <class T>
+	T Read() {
+		Require(sizeof(T));
+		T result;
+		memcpy(&result, ptr, sizeof(T));
+		ptr += sizeof(T);
+		return result;
+	}
+
+	void DecodeWideString(const uint32_t count, vector<char> &out) {
+		Require(idx_t(count) * 2);
+		const auto str_end = ptr + idx_t(count) * 2;
+		while (ptr < str_end) {
+			uint32_t cp = Read<uint16_t>();
+			if (cp >= 0xD800 && cp < 0xDC00 && ptr < str_end) {
+				// A high surrogate, which should be followed by a low one
+				uint16_t low;
+				memcpy(&low, ptr, sizeof(low));
+				if (low >= 0xDC00 && low < 0xE000) {
+					ptr += sizeof(low);
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+				}
+			}
+			if (cp >= 0xD800 && cp < 0xE000) {
+				// Unpaired surrogate
+				cp = 0xFFFD;
+			}
+			AppendUTF8(cp, out);
+		}
+	}
+
+private:
+	const char *ptr;
+	const char *end;
+};
+
+// Read all records of the current entry of the archive, calling callback(type, reader) for every record until it
+// returns false or the entry ends. Only meant for the small parts of a workbook, sheets are parsed by the sheet parser.
+template <class CALLBACK>
+void ReadXLSBRecords(ZipFileReader &stream, CALLBACK &&callback, const idx_t buffer_size = 2048) {
+	const auto buffer_handle = make_unsafe_uniq_array_uninitialized<char>(buffer_size);
+	const auto buffer = buffer_handle.get();
+
+	// Records may span multiple blocks, so keep any incomplete record around
+	vector<char> pending;
+	while (!stream.IsDone()) {
+		const char *block;
+		const auto read_size = stream.ReadBlock(buffer, buffer_size, block);
+		pending.insert(pending.end(), block, block + read_size);
+
+		const char *ptr = pending.data();
+		const auto end = ptr + pending.size();
+		while (true) {
+			auto data = ptr;
+			uint32_t type, size;
+			if (!TryReadXLSBRecordHeader(data, end, type, size) || static_cast<idx_t>(end - data) < size) {
+				break;
+			}
+			XLSBRecordReader reader(data, size);
+			if (!callback(type, reader)) {
+				return;
+			}
+			ptr = data + size;
+		}
+		pending.erase(pending.begin(), pending.begin() + (ptr - pending.data()));
+	}
+	if (!pending.empty()) {
+		throw InvalidInputException("XLSB: Unexpected end of record stream (is the file corrupted?)");
+	}
+}
+
+} // namespace duckdb
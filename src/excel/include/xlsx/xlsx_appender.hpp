@@ -66,6 +66,10 @@ public:
 
 	void Finish();
 
+	XLSXWriteStats GetStats() const {
+		return writer->GetStats();
+	}
+
 private:
 	struct ResolvedStyles {
 		idx_t date = 1;
@@ -342,17 +346,13 @@ inline XLSXAppender::XLSXAppender(ClientContext &context_p, const string &source
 
 		// If the source has duplicate-named entries (some xlsx producers emit them),
 		// copy only the last occurrence — that's the authoritative one per OOXML.
-		const auto names = source.ListEntries();
-		std::unordered_map<string, idx_t> last_index_for;
-		for (idx_t i = 0; i < names.size(); i++) {
-			last_index_for[names[i]] = i;
-		}
+		const auto &names = source.ListEntries();
 
 		idx_t walk_idx = 0;
 		if (source.GotoFirstEntry()) {
 			do {
 				const auto &name = names[walk_idx];
-				const bool is_canonical = last_index_for[name] == walk_idx;
+				const bool is_canonical = source.FindEntry(name) == walk_idx;
 				const bool is_skipped = rewrite_set.count(name) > 0;
 				const bool is_dir = !name.empty() && name.back() == '/';
 				if (is_canonical && !is_skipped && !is_dir) {
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "duckdb/common/list.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include "xlsx/string_table.hpp"
+#include "xlsx/xlsx_parts.hpp"
+#include "xlsx/zip_file.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+class ExtensionLoader;
+
+//-------------------------------------------------------------------
+// Workbook Metadata
+//-------------------------------------------------------------------
+// The sniffed schema of a sheet
+class XLSXSheetSchema {
+public:
+	// The range of the data cells (header not included)
+	XLSXCellRange range;
+	vector<string> column_names;
+	vector<LogicalType> return_types;
+	vector<XLSXCellType> source_types;
+	// The uncompressed size of the sheet
+	idx_t sheet_size = 0;
+	// The estimated number of rows in the range, if it could be estimated
+	optional_idx estimated_rows;
+};
+
+// Everything read_xlsx parses or sniffs from a workbook while binding
+class XLSXWorkbookMetadata {
+public:
+	// All the sheets of the workbook as (name, path), in workbook order. Empty until parsed.
+	vector<pair<string, string>> sheets;
+	// The style sheet, if it has been parsed
+	bool has_style_sheet = false;
+	XLSXStyleSheet style_sheet;
+	// The sniffed schemas, by sheet path and the options used to sniff them
+	unordered_map<string, XLSXSheetSchema> schemas;
+};
+
+//-------------------------------------------------------------------
+// Metadata Cache
+//-------------------------------------------------------------------
+// Caches the workbook metadata across queries, so that binding a
+// query against an unchanged file doesn't inflate anything. Entries
+// are keyed by file path and only used if the fingerprint of the
+// archive (size, modification time and central directory) matches.
+// The number of cached workbooks is capped by the
+// xlsx_metadata_cache_size setting.
+//-------------------------------------------------------------------
+class XLSXMetadataCache final : public ObjectCacheEntry {
+public:
+	static string ObjectType() {
+		return "xlsx_metadata_cache";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	// The cache enforces its own limit, it is never evicted as a whole
+	optional_idx GetEstimatedCacheMemory() const override {
+		return optional_idx();
+	}
+
+	// Get the metadata cache of the database, or nullptr if it is disabled
+	static shared_ptr<XLSXMetadataCache> Get(ClientContext &context);
+
+	// Returns the cached metadata of the file, or nullptr if it is not cached or the file changed
+	shared_ptr<const XLSXWorkbookMetadata> Lookup(const string &file_path, hash_t fingerprint);
+	void Store(const string &file_path, hash_t fingerprint, shared_ptr<const XLSXWorkbookMetadata> metadata);
+
+	struct Entry {
+		string file_path;
+		hash_t fingerprint;
+		shared_ptr<const XLSXWorkbookMetadata> metadata;
+	};
+	// Returns all cached entries, most recently used first
+	vector<Entry> GetEntries();
+
+private:
+	void SetCapacity(idx_t capacity);
+
+	mutex lock;
+	idx_t capacity = 0;
+	// The cached workbooks, most recently used first
+	list<Entry> entries;
+	unordered_map<string, list<Entry>::iterator> index;
+};
+
+//-------------------------------------------------------------------
+// Shared String Cache
+//-------------------------------------------------------------------
+// The shared string table of a workbook is often much larger than
+// the sheets that are read, so it is cached in the object cache of
+// the database and shared by all scans of the workbook, across
+// queries and connections. Cached tables are immutable, and evicted
+// by the object cache when it runs out of memory.
+//-------------------------------------------------------------------
+class XLSXSharedStringsCacheEntry final : public ObjectCacheEntry {
+public:
+	XLSXSharedStringsCacheEntry(hash_t fingerprint_p, shared_ptr<const StringTable> strings_p)
+	    : fingerprint(fingerprint_p), strings(std::move(strings_p)) {
+	}
+
+	static string ObjectType() {
+		return "xlsx_shared_strings";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	optional_idx GetEstimatedCacheMemory() const override {
+		return strings->GetMemoryUsage();
+	}
+
+	// Get the shared strings of the workbook, either from the cache or by parsing them. Returns nullptr if the
+	// workbook has no shared strings.
+	static shared_ptr<const StringTable> Load(ClientContext &context, const string &file_path, ZipFileReader &archive);
+
+	// The fingerprint of the archive and the CRC of the shared strings the table was parsed from
+	hash_t fingerprint;
+	shared_ptr<const StringTable> strings;
+};
+
+//-------------------------------------------------------------------
+// Sheet Index Cache
+//-------------------------------------------------------------------
+// Checkpoints recorded while inflating a large sheet, each mapped to
+// the first row after it, so that later scans can start inflating the
+// sheet right before the rows they need instead of at the beginning.
+// Cached per sheet and only used while the archive fingerprint is
+// unchanged.
+//-------------------------------------------------------------------
+class XLSXSheetCheckpoint {
+public:
+	ZipInflateCheckpoint inflate;
+	// The position of the first row tag after the checkpoint, and its row number
+	idx_t row_pos;
+	idx_t row_number;
+};
+
+class XLSXSheetIndex {
+public:
+	vector<XLSXSheetCheckpoint> checkpoints;
+
+public:
+	// Returns the last checkpoint before the given row, or nullptr if there is none
+	const XLSXSheetCheckpoint *FindCheckpoint(idx_t row_number) const;
+	idx_t GetMemoryUsage() const;
+};
+
+class XLSXSheetIndexCacheEntry final : public ObjectCacheEntry {
+public:
+	XLSXSheetIndexCacheEntry(hash_t fingerprint_p, shared_ptr<const XLSXSheetIndex> index_p)
+	    : fingerprint(fingerprint_p), index(std::move(index_p)) {
+	}
+
+	static string ObjectType() {
+		return "xlsx_sheet_index";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	optional_idx GetEstimatedCacheMemory() const override {
+		return index->GetMemoryUsage();
+	}
+
+	// Returns the cached index of the sheet, or nullptr if there is none or the file changed
+	static shared_ptr<const XLSXSheetIndex> Lookup(ClientContext &context, const string &file_path,
+	                                               const string &sheet_path, hash_t fingerprint);
+	// Cache the index of the sheet, unless an index with at least as many checkpoints is already cached
+	static void Store(ClientContext &context, const string &file_path, const string &sheet_path, hash_t fingerprint,
+	                  shared_ptr<const XLSXSheetIndex> index);
+
+	hash_t fingerprint;
+	shared_ptr<const XLSXSheetIndex> index;
+};
+
+//-------------------------------------------------------------------
+// Result Cache
+//-------------------------------------------------------------------
+// Opt-in cache of the decoded rows of read_xlsx scans, enabled by
+// the xlsx_result_cache setting. Every sheet is cached separately,
+// keyed by file path, sheet, range, options and the columns read,
+// and only replayed as long as the fingerprint of the archive is
+// unchanged. The rows are stored in buffer managed collections, so
+// they can be spilled like any other data, and the least recently
+// used sheets are dropped once the cache takes up more than a
+// quarter of the memory limit.
+//-------------------------------------------------------------------
+class XLSXResultCache final : public ObjectCacheEntry {
+public:
+	static string ObjectType() {
+		return "xlsx_result_cache";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	// The cache enforces its own limit, it is never evicted as a whole
+	optional_idx GetEstimatedCacheMemory() const override {
+		return optional_idx();
+	}
+
+	// Get the result cache of the database, or nullptr if it is disabled
+	static shared_ptr<XLSXResultCache> Get(ClientContext &context);
+
+	// Returns the cached rows, or nullptr if they are not cached or the file changed
+	shared_ptr<const ColumnDataCollection> Lookup(const string &key, hash_t fingerprint);
+	void Store(ClientContext &context, const string &key, const string &file_path, const string &sheet_name,
+	           hash_t fingerprint, shared_ptr<const ColumnDataCollection> rows);
+	// Drop all cached results
+	void Clear();
+
+	struct Entry {
+		string key;
+		string file_path;
+		string sheet_name;
+		hash_t fingerprint;
+		shared_ptr<const ColumnDataCollection> rows;
+	};
+	// Returns all cached entries, most recently used first
+	vector<Entry> GetEntries();
+
+private:
+	mutex lock;
+	// The cached sheets, most recently used first
+	list<Entry> entries;
+	unordered_map<string, list<Entry>::iterator> index;
+	// The total size of the cached rows
+	idx_t size = 0;
+};
+
+struct XLSXCache {
+	// Register the cache settings and the functions to inspect the caches
+	static void Register(ExtensionLoader &loader);
+};
+
+} // namespace duckdb
@@ -5,6 +5,15 @@
 
 namespace duckdb {
 
+// What a writer did so far, for profiling
+struct XLSXWriteStats {
+	idx_t rows_written = 0;
+	// The bytes of strings run through XML escaping
+	idx_t bytes_escaped = 0;
+	idx_t bytes_deflated = 0;
+	idx_t bytes_written = 0;
+};
+
 class XLXSWriter {
 public:
 	void BeginSheet(const string &sheet_name, const vector<string> &sql_column_names,
@@ -27,8 +36,18 @@ public:
 	void WriteTimestampCell(const string_t &value);
 	void WriteTimestampCellNoMilliseconds(const string_t &value);
 	void WriteEmptyCell();
+	// Write a reference to a string added with AddSharedString
+	void WriteSharedStringCell(idx_t string_idx);
 	void BeginRow();
 	void EndRow();
+	// Leave the next rows of the sheet empty
+	void SkipRows(idx_t count);
+
+	// Add a string to the shared string table of the workbook, returns its index
+	idx_t AddSharedString(const string &str);
+	// Declare the content type of the parts with the given extension, for parts written to the stream directly.
+	// Every part of the package needs one.
+	void AddDefaultContentType(const string &extension, const string &content_type);
 
 	void Finish();
 
@@ -42,6 +61,8 @@ public:
 		return stream;
 	}
 
+	XLSXWriteStats GetStats() const;
+
 private:
 	idx_t WriteEscapedXML(const char *str);
 	idx_t WriteEscapedXML(const string &str);
@@ -54,6 +75,7 @@ private:
 	void WriteDocProps();
 	void WriteSharedStrings();
 	void WritePackageRels();
+	void AdvanceRows(idx_t count);
 
 	class XLSXSheet {
 	public:
@@ -84,7 +106,16 @@ private:
 	XLSXSheet active_sheet;
 	vector<XLSXSheet> written_sheets;
 
+	// The shared string table, and the number of cells referencing it
+	vector<string> shared_strings;
+	idx_t shared_string_refs = 0;
+
+	// The content types of the extensions of other parts, besides xml and rels
+	vector<pair<string, string>> default_content_types;
+
 	vector<char> escaped_buffer;
+	idx_t bytes_escaped = 0;
+	idx_t rows_written = 0;
 };
 
 static constexpr auto ENCODING_FRAGMENT = R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
@@ -249,6 +280,20 @@ inline void XLXSWriter::WriteEmptyCell() {
 	col_idx++;
 }
 
+inline void XLXSWriter::WriteSharedStringCell(idx_t string_idx) {
+	D_ASSERT(string_idx < shared_strings.size());
+	stream.Write("<c r=\"" + active_sheet.sheet_column_names[col_idx] + row_str + "\" t=\"s\"><v>" +
+	             std::to_string(string_idx) + "</v></c>");
+	shared_string_refs++;
+
+	col_idx++;
+}
+
+inline idx_t XLXSWriter::AddSharedString(const string &str) {
+	shared_strings.push_back(str);
+	return shared_strings.size() - 1;
+}
+
 inline void XLXSWriter::BeginRow() {
 	stream.Write("<row r=\"" + row_str + "\">");
 }
@@ -257,7 +302,17 @@ inline void XLXSWriter::EndRow() {
 	stream.Write("</row>");
 	col_idx = 0;
 
-	row_idx++;
+	rows_written++;
+	AdvanceRows(1);
+}
+
+inline void XLXSWriter::SkipRows(idx_t count) {
+	D_ASSERT(col_idx == 0);
+	AdvanceRows(count);
+}
+
+inline void XLXSWriter::AdvanceRows(idx_t count) {
+	row_idx += count;
 	row_str = std::to_string(row_idx + 1);
 
 	if (row_idx > sheet_row_limit) {
@@ -298,9 +353,20 @@ inline idx_t XLXSWriter::WriteEscapedXML(const string &str) {
 inline idx_t XLXSWriter::WriteEscapedXML(const char *buffer, idx_t write_size) {
 	escaped_buffer.clear();
 	EscapeXMLString(buffer, write_size, escaped_buffer);
+	bytes_escaped += write_size;
 	return stream.Write(escaped_buffer.data(), escaped_buffer.size());
 }
 
+inline XLSXWriteStats XLXSWriter::GetStats() const {
+	const auto zip_stats = stream.GetStats();
+	XLSXWriteStats stats;
+	stats.rows_written = rows_written;
+	stats.bytes_escaped = bytes_escaped;
+	stats.bytes_deflated = zip_stats.bytes_deflated;
+	stats.bytes_written = zip_stats.bytes_written;
+	return stats;
+}
+
 inline void XLXSWriter::WriteStyles() {
 	//--------------------------------------------------------------------------------------------------
 	// The number formats we write to the styles.xml file
@@ -368,6 +434,15 @@ inline void XLXSWriter::WriteStyles() {
 	stream.EndFile();
 }
 
+inline void XLXSWriter::AddDefaultContentType(const string &extension, const string &content_type) {
+	for (const auto &entry : default_content_types) {
+		if (StringUtil::CIEquals(entry.first, extension)) {
+			return;
+		}
+	}
+	default_content_types.emplace_back(extension, content_type);
+}
+
 inline void XLXSWriter::WriteContentTypes() {
 	static constexpr auto CONTENT_TYPES_XML_START =
 	    R"(<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">)"
@@ -383,6 +458,9 @@ inline void XLXSWriter::WriteContentTypes() {
 	stream.BeginFile("[Content_Types].xml");
 	stream.Write(ENCODING_FRAGMENT);
 	stream.Write(CONTENT_TYPES_XML_START);
+	for (const auto &entry : default_content_types) {
+		stream.Write(StringUtil::Format("<Default Extension=\"%s\" ContentType=\"%s\"/>", entry.first, entry.second));
+	}
 	for (const auto &sheet : written_sheets) {
 		stream.Write(StringUtil::Format(
 		    "<Override PartName=\"/xl/worksheets/%s\" "
@@ -464,13 +542,20 @@ inline void XLXSWriter::WriteWorkbook() {
 }
 
 inline void XLXSWriter::WriteSharedStrings() {
-	// We dont use shared strings for now, but still create a dummy file
-	static constexpr auto SHARED_STRINGS_XML =
-	    R"(<sst xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" count="0" uniqueCount="0"/>)";
+	// Cells are written inline unless strings were added explicitly, but the file is always created
+	static constexpr auto SHARED_STRINGS_XML_START =
+	    R"(<sst xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" count="%d" uniqueCount="%d">)";
+	static constexpr auto SHARED_STRINGS_XML_END = R"(</sst>)";
 
 	stream.BeginFile("xl/sharedStrings.xml");
 	stream.Write(ENCODING_FRAGMENT);
-	stream.Write(SHARED_STRINGS_XML);
+	stream.Write(StringUtil::Format(SHARED_STRINGS_XML_START, shared_string_refs, shared_strings.size()));
+	for (const auto &str : shared_strings) {
+		stream.Write("<si><t>");
+		WriteEscapedXML(str);
+		stream.Write("</t></si>");
+	}
+	stream.Write(SHARED_STRINGS_XML_END);
 	stream.EndFile();
 }
 
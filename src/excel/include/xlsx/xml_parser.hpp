@@ -31,6 +31,15 @@ protected:
 	bool IsSuspended() const {
 		return state == XMLParseResult::SUSPENDED;
 	}
+	XMLParseResult GetStatus() const {
+		return state;
+	}
+	// Reset the parser to parse a new document. The callbacks stay in place.
+	void Reset();
+	// The offset in the input (across all calls to Parse) just past the current element. Only valid in a callback.
+	idx_t GetCurrentElementEnd() const;
+	// The offset in the input of the start of the current element. Only valid in a callback.
+	idx_t GetCurrentElementBegin() const;
 
 	virtual void OnResume() {
 	}
@@ -42,6 +51,8 @@ protected:
 	static bool MatchTag(const char *tag, const char *name, bool strip_prefix = true);
 
 private:
+	void InitParser();
+
 	XML_Parser parser;
 
 	// enum class ParseState { OK, PAUSED, DONE};
@@ -51,7 +62,14 @@ private:
 };
 
 inline XMLParser::XMLParser() : parser(XML_ParserCreate(nullptr)) {
+	InitParser();
+}
+
+inline XMLParser::~XMLParser() {
+	XML_ParserFree(parser);
+}
 
+inline void XMLParser::InitParser() {
 	XML_SetUserData(parser, this);
 
 	XML_SetStartElementHandler(parser, [](void *self_ptr, const XML_Char *name, const XML_Char **atts) {
@@ -65,8 +83,20 @@ inline XMLParser::XMLParser() : parser(XML_ParserCreate(nullptr)) {
 	});
 }
 
-inline XMLParser::~XMLParser() {
-	XML_ParserFree(parser);
+inline void XMLParser::Reset() {
+	XML_ParserReset(parser, nullptr);
+	InitParser();
+	state = XMLParseResult::OK;
+	in_parser = false;
+}
+
+inline idx_t XMLParser::GetCurrentElementEnd() const {
+	const auto offset = XML_GetCurrentByteIndex(parser) + XML_GetCurrentByteCount(parser);
+	return NumericCast<idx_t>(offset);
+}
+
+inline idx_t XMLParser::GetCurrentElementBegin() const {
+	return NumericCast<idx_t>(XML_GetCurrentByteIndex(parser));
 }
 
 inline XMLParseResult XMLParser::Parse(const char *buffer, const idx_t len, const bool final) {
@@ -115,6 +145,13 @@ inline XMLParseResult XMLParser::Resume() {
 		return state;
 	}
 
+	// The parser might have been stopped outside of Parse() or Resume(), in which case expat itself is not suspended
+	XML_ParsingStatus parsing_status;
+	XML_GetParsingStatus(parser, &parsing_status);
+	if (parsing_status.parsing != XML_SUSPENDED) {
+		return state;
+	}
+
 	in_parser = true;
 	const auto status = XML_ResumeParser(parser);
 	in_parser = false;
@@ -165,8 +202,9 @@ inline void XMLParser::ParseAll(ZipFileReader &stream, const idx_t buffer_size)
 
 	// Read the stream in chunks and parse it until done or cancelled, resuming if necessary
 	while (!stream.IsDone()) {
-		const auto read_size = stream.Read(buffer, buffer_size);
-		auto status = Parse(buffer, read_size, stream.IsDone());
+		const char *block;
+		const auto read_size = stream.ReadBlock(buffer, buffer_size, block);
+		auto status = Parse(block, read_size, stream.IsDone());
 		while (status == XMLParseResult::SUSPENDED) {
 			status = Resume();
 		}
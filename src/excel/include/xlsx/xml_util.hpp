@@ -3,6 +3,8 @@
 #include "duckdb/common/typedefs.hpp"
 #include "duckdb/common/string.hpp"
 
+#include <cstring>
+
 namespace duckdb {
 
 template <class T>
@@ -42,4 +44,214 @@ inline string EscapeXMLString(const string &str) {
 	return result;
 }
 
+//-------------------------------------------------------------------
+// XML Scanning
+//-------------------------------------------------------------------
+// Byte-level helpers to scan UTF-8 encoded XML without a full parser.
+// These do not validate the markup, callers are expected to fall back
+// to a real parser for anything they do not recognize.
+//-------------------------------------------------------------------
+
+inline bool IsXMLSpace(const char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline const char *SkipXMLSpace(const char *ptr, const char *end) {
+	while (ptr < end && IsXMLSpace(*ptr)) {
+		ptr++;
+	}
+	return ptr;
+}
+
+// Skip over a tag name, returning the position of the first character after it
+inline const char *SkipXMLName(const char *ptr, const char *end) {
+	while (ptr < end && !IsXMLSpace(*ptr) && *ptr != '>' && *ptr != '/') {
+		ptr++;
+	}
+	return ptr;
+}
+
+// Check if the tag name in [beg, end) matches the given local name, ignoring any namespace prefix
+inline bool MatchXMLName(const char *beg, const char *end, const char *tag) {
+	const auto colon = static_cast<const char *>(memchr(beg, ':', static_cast<size_t>(end - beg)));
+	if (colon) {
+		beg = colon + 1;
+	}
+	const auto tag_len = strlen(tag);
+	return static_cast<size_t>(end - beg) == tag_len && memcmp(beg, tag, tag_len) == 0;
+}
+
+// Find the '>' closing the tag at ptr, skipping over quoted attribute values.
+// Returns nullptr if the tag is not complete.
+inline const char *FindXMLTagEnd(const char *ptr, const char *end) {
+	while (ptr < end) {
+		const auto c = *ptr;
+		if (c == '>') {
+			return ptr;
+		}
+		if (c == '"' || c == '\'') {
+			const auto quote = static_cast<const char *>(memchr(ptr + 1, c, static_cast<size_t>(end - ptr - 1)));
+			if (!quote) {
+				return nullptr;
+			}
+			ptr = quote + 1;
+		} else {
+			ptr++;
+		}
+	}
+	return nullptr;
+}
+
+// A raw attribute of a start tag, pointing into the scanned buffer
+struct XMLRawAttribute {
+	const char *name_beg;
+	const char *name_end;
+	const char *value_beg;
+	const char *value_end;
+
+	bool NameIs(const char *name) const {
+		const auto len = strlen(name);
+		return static_cast<size_t>(name_end - name_beg) == len && memcmp(name_beg, name, len) == 0;
+	}
+
+	// Copy the value into a null-terminated buffer. Returns false if the value does not fit,
+	// or would have to be unescaped first.
+	template <idx_t N>
+	bool TryCopyValue(char (&buffer)[N]) const {
+		const auto len = static_cast<idx_t>(value_end - value_beg);
+		if (len >= N || memchr(value_beg, '&', len)) {
+			return false;
+		}
+		memcpy(buffer, value_beg, len);
+		buffer[len] = '\0';
+		return true;
+	}
+};
+
+// Read the next attribute of a start tag, with ptr positioned after the tag name or the previous attribute.
+// Returns false when there are no more attributes, leaving ptr at the closing '>' or '/>', or set to nullptr if the
+// tag is malformed or incomplete.
+inline bool ReadXMLAttribute(const char *&ptr, const char *end, XMLRawAttribute &attr) {
+	ptr = SkipXMLSpace(ptr, end);
+	if (ptr == end) {
+		ptr = nullptr;
+		return false;
+	}
+	if (*ptr == '>' || *ptr == '/') {
+		return false;
+	}
+	attr.name_beg = ptr;
+	while (ptr < end && *ptr != '=' && !IsXMLSpace(*ptr) && *ptr != '>' && *ptr != '/') {
+		ptr++;
+	}
+	attr.name_end = ptr;
+	ptr = SkipXMLSpace(ptr, end);
+	if (ptr == end || *ptr != '=') {
+		ptr = nullptr;
+		return false;
+	}
+	ptr = SkipXMLSpace(ptr + 1, end);
+	if (ptr == end || (*ptr != '"' && *ptr != '\'')) {
+		ptr = nullptr;
+		return false;
+	}
+	const auto quote = *ptr++;
+	attr.value_beg = ptr;
+	ptr = static_cast<const char *>(memchr(ptr, quote, static_cast<size_t>(end - ptr)));
+	if (!ptr) {
+		return false;
+	}
+	attr.value_end = ptr++;
+	return true;
+}
+
+// Append a code point to a UTF-8 string
+template <class T>
+void AppendUTF8(const uint32_t code, T &out) {
+	if (code < 0x80) {
+		out.push_back(static_cast<char>(code));
+	} else if (code < 0x800) {
+		out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+		out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+	} else if (code < 0x10000) {
+		out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+		out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+		out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+	} else {
+		out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+		out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+		out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+		out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+	}
+}
+
+// Append the character data in [beg, end) to out, replacing the predefined entities and character references.
+// Returns false if the data contains anything else that a parser would have to normalize or reject.
+template <class T>
+bool TryUnescapeXMLText(const char *beg, const char *end, T &out) {
+	while (beg < end) {
+		const auto amp = static_cast<const char *>(memchr(beg, '&', static_cast<size_t>(end - beg)));
+		const auto run_end = amp ? amp : end;
+		if (memchr(beg, '\r', static_cast<size_t>(run_end - beg))) {
+			// Line endings are normalized by the parser
+			return false;
+		}
+		out.insert(out.end(), beg, run_end);
+		if (!amp) {
+			return true;
+		}
+
+		const auto semi = static_cast<const char *>(memchr(amp, ';', static_cast<size_t>(end - amp)));
+		if (!semi) {
+			return false;
+		}
+		const auto name = amp + 1;
+		const auto name_len = static_cast<idx_t>(semi - name);
+		if (name_len == 2 && memcmp(name, "lt", 2) == 0) {
+			out.push_back('<');
+		} else if (name_len == 2 && memcmp(name, "gt", 2) == 0) {
+			out.push_back('>');
+		} else if (name_len == 3 && memcmp(name, "amp", 3) == 0) {
+			out.push_back('&');
+		} else if (name_len == 4 && memcmp(name, "quot", 4) == 0) {
+			out.push_back('"');
+		} else if (name_len == 4 && memcmp(name, "apos", 4) == 0) {
+			out.push_back('\'');
+		} else if (name_len >= 2 && name[0] == '#') {
+			// Character reference, encode it as UTF-8
+			const auto hex = name[1] == 'x';
+			uint32_t code = 0;
+			for (auto ptr = name + (hex ? 2 : 1); ptr < semi; ptr++) {
+				const auto c = *ptr;
+				uint32_t digit;
+				if (c >= '0' && c <= '9') {
+					digit = static_cast<uint32_t>(c - '0');
+				} else if (hex && c >= 'a' && c <= 'f') {
+					digit = static_cast<uint32_t>(c - 'a' + 10);
+				} else if (hex && c >= 'A' && c <= 'F') {
+					digit = static_cast<uint32_t>(c - 'A' + 10);
+				} else {
+					return false;
+				}
+				code = code * (hex ? 16 : 10) + digit;
+				if (code > 0x10FFFF) {
+					return false;
+				}
+			}
+			// Only characters that are allowed in XML
+			const auto is_control = code < 0x20 && code != '\t' && code != '\n' && code != '\r';
+			const auto is_surrogate = code >= 0xD800 && code <= 0xDFFF;
+			if (is_control || is_surrogate || code == 0xFFFE || code == 0xFFFF || (hex && name_len == 2)) {
+				return false;
+			}
+			AppendUTF8(code, out);
+		} else {
+			// Entities declared in a DTD are left to the parser
+			return false;
+		}
+		beg = semi + 1;
+	}
+	return true;
+}
+
 } // namespace duckdb
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "duckdb/common/typedefs.hpp"
 #include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/vector.hpp"
 
 namespace duckdb {
@@ -9,6 +11,27 @@ namespace duckdb {
 class ClientContext;
 
 class ZipFileReader;
+class ZipEntryDecoder;
+class ZipFileMapping;
+class ZipFileSource;
+
+// A position in a deflated entry from which it can be inflated without inflating everything before it, as in zlib's
+// zran example: the bit position in the compressed data, and the last 32KB of uncompressed data before it.
+struct ZipInflateCheckpoint {
+	// The position in the uncompressed data
+	idx_t out_pos = 0;
+	// The position in the compressed data, and the number of bits of the byte before it that are still unused
+	idx_t in_pos = 0;
+	uint8_t in_bits = 0;
+	// The uncompressed data before out_pos, at most 32KB
+	string window;
+};
+
+// What a writer deflated and wrote to the file so far
+struct ZipWriteStats {
+	idx_t bytes_deflated = 0;
+	idx_t bytes_written = 0;
+};
 
 class ZipFileWriter {
 public:
@@ -31,15 +54,28 @@ public:
 	// Raw-copy the source reader's current entry (no decompress/recompress).
 	void CopyCurrentEntryFrom(ZipFileReader &source);
 
+	// Returns the bytes deflated (uncompressed) and written to the file (compressed) so far
+	ZipWriteStats GetStats() const;
+
 private:
 	void *handle;
 	void *stream;
 	bool is_entry_open;
+	idx_t bytes_deflated = 0;
 	vector<char> escaped_buffer;
 };
 
+// What a reader read from the file and inflated so far
+struct ZipReadStats {
+	idx_t bytes_read = 0;
+	idx_t bytes_inflated = 0;
+};
+
 class ZipFileReader {
 public:
+	// Deflated entries up to this (uncompressed) size are inflated into memory in a single pass by default
+	static constexpr idx_t DEFAULT_INFLATE_BUFFER_SIZE = 32ULL * 1024 * 1024;
+
 	ZipFileReader(ClientContext &context, const string &file_name);
 	~ZipFileReader();
 
@@ -47,9 +83,31 @@ public:
 	ZipFileReader(const ZipFileReader &) = delete;
 	ZipFileReader &operator=(const ZipFileReader &) = delete;
 
+	// Entries are only prefetched if they are at most this large (compressed)
+	static constexpr idx_t MAX_PREFETCH_SIZE = 1024ULL * 1024;
+	// Read the given entries (if they exist and are small enough) ahead of time, merging the reads of entries that
+	// are close to each other in the file. Opening them later doesn't read from the file again.
+	void Prefetch(const vector<string> &file_names);
+
+	// Open an entry to read all of it. Deflated entries that fit in the inflate buffer are inflated in a single pass.
 	bool TryOpenEntry(const string &file_name);
+	// Open an entry to stream it, and record a checkpoint about every `checkpoint_span` bytes of uncompressed data
+	// while it is read (none if 0). Entries that are not deflated are opened as usual, without any checkpoints.
+	bool TryOpenEntry(const string &file_name, idx_t checkpoint_span);
+	// Open an entry and continue inflating it at a checkpoint recorded for the same entry of the same archive
+	bool TryResumeEntry(const string &file_name, const ZipInflateCheckpoint &checkpoint);
 	void CloseEntry();
 	idx_t Read(char *buffer, idx_t read_size);
+	// Get the next bytes of the current entry, either read into the buffer or pointing straight into the inflated
+	// entry or the mapped file. The block stays valid until the next read. Returns the size of the block.
+	idx_t ReadBlock(char *buffer, idx_t read_size, const char *&block);
+	// Read and discard the next `skip_size` bytes of the current entry. Returns the number of bytes skipped.
+	idx_t Skip(idx_t skip_size);
+	// The checkpoints recorded for the current entry so far
+	const vector<ZipInflateCheckpoint> &GetCheckpoints() const;
+
+	// Returns the bytes read from the file and inflated by this reader so far
+	ZipReadStats GetStats() const;
 
 	// Returns the current position in the current entry
 	idx_t GetEntryPos() const;
@@ -59,11 +117,20 @@ public:
 	bool IsDone() const;
 
 	// Returns the names of all entries in the archive.
-	vector<string> ListEntries();
+	const vector<string> &ListEntries() const;
+	// Returns the position of the entry with the given name in ListEntries(), or DConstants::INVALID_INDEX.
+	// If the name occurs more than once, the last occurrence is returned.
+	idx_t FindEntry(const string &entry_name) const;
 
 	// Returns true if `entry_name` exists and is a directory entry.
 	bool EntryIsDirectory(const string &entry_name);
 
+	// Returns a hash of the file size, modification time and the central directory (the names, sizes and CRCs of
+	// all entries), which changes whenever the content of the archive does.
+	hash_t GetFingerprint() const;
+	// Returns the CRC-32 of the entry at the given position in ListEntries()
+	uint32_t GetEntryCRC(idx_t entry_idx) const;
+
 	// Sequential entry-walking primitives. After Goto* returns true the reader is positioned
 	// on an entry; Current* / ZipFileWriter::CopyCurrentEntryFrom are then valid.
 	bool GotoFirstEntry();
@@ -74,12 +141,38 @@ public:
 private:
 	friend class ZipFileWriter;
 
+	void BuildIndex();
+	bool GotoEntry(idx_t entry_idx);
+	// Open the current entry with our own decoder instead of minizip's, if it is stored or deflated. Small enough
+	// deflated entries are inflated in a single pass if allowed, the others are streamed.
+	bool TryOpenDecoder(idx_t entry_idx, idx_t checkpoint_span, bool allow_buffer);
+	bool TryOpenMinizipEntry();
+
 	void *handle;
 	void *stream;
 	bool is_entry_open;
 
 	idx_t entry_pos;
 	idx_t entry_len;
+	// The file the entries are decoded from, memory mapped if enabled (the xlsx_memory_map setting) and possible
+	unique_ptr<ZipFileMapping> mapping;
+	unique_ptr<ZipFileSource> source;
+	// Set if the current entry is decoded by us instead of minizip
+	unique_ptr<ZipEntryDecoder> decoder;
+	// The largest entry to inflate in a single pass (the xlsx_inflate_buffer_size setting)
+	idx_t inflate_buffer_size = DEFAULT_INFLATE_BUFFER_SIZE;
+	// Whether the current entry is inflated as it is read, and the total bytes inflated
+	bool is_inflating = false;
+	idx_t bytes_inflated = 0;
+
+	// The central directory, indexed once when the archive is opened
+	vector<string> entry_names;
+	vector<int64_t> entry_offsets;
+	vector<uint32_t> entry_crcs;
+	// The position of the local header and the compressed size of each entry
+	vector<pair<idx_t, idx_t>> entry_ranges;
+	unordered_map<string, idx_t> entry_index;
+	hash_t fingerprint;
 };
 
 } // namespace duckdb
\ No newline at end of file
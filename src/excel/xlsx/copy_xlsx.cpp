@@ -1,7 +1,9 @@
 #include "duckdb/common/exception/conversion_exception.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/common/profiler.hpp"
 #include "duckdb/function/copy_function.hpp"
+#include "duckdb/logging/logger.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/planner/expression/bound_cast_expression.hpp"
@@ -198,6 +200,11 @@ struct GlobalWriteXLSXData final : public GlobalFunctionData {
 	ExpressionExecutor executor;
 	vector<unique_ptr<Expression>> conversion_expressions;
 
+	// Where the time of the copy goes, logged when it is done (in seconds)
+	string target_path;
+	double cast_time = 0;
+	double write_time = 0;
+
 	GlobalWriteXLSXData(ClientContext &context, const string &file_path, const WriteXLSXData &data) : executor(context) {
 
 		// MODE 'append'/'replace' reads the existing workbook and atomically swaps a rebuilt
@@ -215,7 +222,7 @@ struct GlobalWriteXLSXData final : public GlobalFunctionData {
 		auto &fs = FileSystem::GetFileSystem(context);
 		// data.file_path is the user-typed path (may contain `~`); the framework hands us
 		// `file_path` as the temp it'll rename. Expand the user-typed path before checking.
-		const auto target_path = fs.ExpandPath(data.file_path);
+		target_path = fs.ExpandPath(data.file_path);
 		const bool target_exists = fs.FileExists(target_path);
 		const bool use_appender = (data.append || data.replace) && target_exists;
 
@@ -344,6 +351,9 @@ struct WriteDispatch {
 			state.fresh_writer->WriteInlineStringCell(v);
 		}
 	}
+	XLSXWriteStats GetStats() const {
+		return state.appender ? state.appender->GetStats() : state.fresh_writer->GetStats();
+	}
 };
 } // namespace
 
@@ -399,8 +409,13 @@ static void Sink(ExecutionContext &context, FunctionData &bind_data, GlobalFunct
 	// NULL bits chunk-to-chunk, so on wide, multi-chunk sheets scanned from an
 	// encoded source (e.g. parquet) populated cells are progressively emitted as
 	// NULL and silently dropped.
+	Profiler timer;
+	timer.Start();
 	state.cast_chunk.Reset();
 	state.executor.Execute(input, state.cast_chunk);
+	timer.End();
+	state.cast_time += timer.Elapsed();
+	timer.Start();
 
 	// Then, setup unified formats for the cast columns
 	vector<UnifiedVectorFormat> formats;
@@ -468,6 +483,8 @@ static void Sink(ExecutionContext &context, FunctionData &bind_data, GlobalFunct
 		}
 		writer.EndRow();
 	}
+	timer.End();
+	state.write_time += timer.Elapsed();
 }
 
 //------------------------------------------------------------------------------
@@ -483,12 +500,24 @@ static void Combine(ExecutionContext &context, FunctionData &bind_data, GlobalFu
 static void Finalize(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate) {
 	auto &state = gstate.Cast<GlobalWriteXLSXData>();
 
+	Profiler timer;
+	timer.Start();
 	if (state.appender) {
 		state.appender->Finish();
 	} else {
 		state.fresh_writer->EndSheet();
 		state.fresh_writer->Finish();
 	}
+	timer.End();
+
+	// Copy functions have no way to add to the profile of the operator, so the counters go to the log instead
+	const auto stats = WriteDispatch {state}.GetStats();
+	const auto message = StringUtil::Format(
+	    "xlsx write \"%s\": %llu rows, %llu bytes escaped, %llu bytes deflated, %llu bytes written, "
+	    "cast %.3fs, write %.3fs, finish %.3fs",
+	    state.target_path, stats.rows_written, stats.bytes_escaped, stats.bytes_deflated, stats.bytes_written,
+	    state.cast_time, state.write_time, timer.Elapsed());
+	DUCKDB_LOG_INFO(context, message.c_str());
 }
 
 //------------------------------------------------------------------------------
@@ -536,6 +565,19 @@ static void SetVarcharValue(named_parameter_map_t &params, const string &key, co
 	params[key] = val.back();
 }
 
+static void SetBigIntValue(named_parameter_map_t &params, const string &key, const vector<Value> &val) {
+	static constexpr auto error_msg = "'%s' option must be a single integer value";
+	if (val.size() != 1) {
+		throw BinderException(error_msg, key);
+	}
+	Value value;
+	string error;
+	if (val.back().IsNull() || !val.back().DefaultTryCastAs(LogicalType::BIGINT, value, &error)) {
+		throw BinderException(error_msg, key);
+	}
+	params[key] = value;
+}
+
 static void ParseCopyFromOptions(XLSXReadData &data, const case_insensitive_map_t<vector<Value>> &options) {
 
 	// Just make it really easy for us, extract everything into a named parameter map
@@ -556,6 +598,8 @@ static void ParseCopyFromOptions(XLSXReadData &data, const case_insensitive_map_
 			SetVarcharValue(named_parameters, key, val);
 		} else if (key == "stop_at_empty") {
 			SetBooleanValue(named_parameters, key, val);
+		} else if (key == "sample_size") {
+			SetBigIntValue(named_parameters, key, val);
 		} else if (key == "empty_as_varchar") {
 			SetBooleanValue(named_parameters, key, val);
 		}
@@ -574,8 +618,7 @@ static unique_ptr<FunctionData> CopyFromBind(ClientContext &context, CopyFromFun
 	// TODO: Parse options
 	ParseCopyFromOptions(*result, input.info.options);
 
-	ZipFileReader archive(context, input.info.file_path);
-	ReadXLSX::ResolveSheet(result, archive);
+	ReadXLSX::ResolveSheet(context, result);
 
 	// Column count mismatch!
 	if (expected_types.size() != result->return_types.size()) {
@@ -0,0 +1,381 @@
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "xlsx/read_xlsx.hpp"
+#include "xlsx/xlsx_writer.hpp"
+
+#include <cmath>
+
+namespace duckdb {
+
+//------------------------------------------------------------------------------
+// Options
+//------------------------------------------------------------------------------
+// xlsx_generate(path, rows, columns, ...) writes a workbook with a single sheet
+// of synthetic data, to reproduce the shape of large workbooks without shipping
+// them. The first column holds the row number, the others hold strings, numbers
+// or date-styled numbers. Every cell is derived from a hash of the seed, its row
+// and its column, so the same arguments always produce the same workbook.
+//------------------------------------------------------------------------------
+class XLSXGenerateOptions {
+public:
+	string sheet_name = "Sheet1";
+	bool header = true;
+	// The fraction of the columns (besides the row number) holding strings
+	double string_columns = 0.5;
+	// The fraction of the string cells written to the shared string table, the others are written inline
+	double shared_strings = 1.0;
+	// The number of distinct strings
+	idx_t cardinality = 1000;
+	// The fraction of the cells (besides the row number) left empty
+	double sparsity = 0;
+	// The fraction of the numeric columns styled as dates
+	double date_columns = 0;
+	// Leave a row empty after every this many rows, 0 for none
+	idx_t row_gap = 0;
+	// The number of parts no sheet refers to, written before the sheet, and their size
+	idx_t junk_parts = 0;
+	idx_t junk_size = 1024 * 1024;
+	uint64_t seed = 0;
+};
+
+enum class XLSXGenerateColumn : uint8_t { ROW_NUMBER, NUMBER, DATE, STRING };
+
+class XLSXGenerateData final : public TableFunctionData {
+public:
+	string file_path;
+	idx_t row_count;
+	vector<XLSXGenerateColumn> columns;
+	XLSXGenerateOptions options;
+};
+
+static double GetFraction(const Value &value, const char *name) {
+	const auto fraction = DoubleValue::Get(value);
+	if (!(fraction >= 0 && fraction <= 1)) {
+		throw BinderException("xlsx_generate: '%s' must be between 0 and 1", name);
+	}
+	return fraction;
+}
+
+static void ParseGenerateOptions(XLSXGenerateOptions &options, const named_parameter_map_t &input) {
+	for (auto &kv : input) {
+		const auto &name = kv.first;
+		const auto &value = kv.second;
+		if (value.IsNull()) {
+			throw BinderException("xlsx_generate: '%s' must not be NULL", name);
+		}
+		if (name == "sheet") {
+			options.sheet_name = StringValue::Get(value);
+			if (options.sheet_name.empty()) {
+				throw BinderException("xlsx_generate: the sheet name must not be empty");
+			}
+		} else if (name == "header") {
+			options.header = BooleanValue::Get(value);
+		} else if (name == "string_columns") {
+			options.string_columns = GetFraction(value, "string_columns");
+		} else if (name == "shared_strings") {
+			options.shared_strings = GetFraction(value, "shared_strings");
+		} else if (name == "cardinality") {
+			options.cardinality = UBigIntValue::Get(value);
+			if (options.cardinality == 0) {
+				throw BinderException("xlsx_generate: 'cardinality' must be at least 1");
+			}
+		} else if (name == "sparsity") {
+			options.sparsity = GetFraction(value, "sparsity");
+		} else if (name == "date_columns") {
+			options.date_columns = GetFraction(value, "date_columns");
+		} else if (name == "row_gap") {
+			options.row_gap = UBigIntValue::Get(value);
+		} else if (name == "junk_parts") {
+			options.junk_parts = UBigIntValue::Get(value);
+		} else if (name == "junk_size") {
+			options.junk_size = UBigIntValue::Get(value);
+		} else if (name == "seed") {
+			options.seed = UBigIntValue::Get(value);
+		}
+	}
+}
+
+// Spread `count` of `total` columns evenly, returns whether the column at `idx` is one of them
+static bool IsSpreadColumn(idx_t idx, idx_t count, idx_t total) {
+	return (idx + 1) * count / total > idx * count / total;
+}
+
+//------------------------------------------------------------------------------
+// Bind
+//------------------------------------------------------------------------------
+static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+                                     vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<XLSXGenerateData>();
+	for (auto &arg : input.inputs) {
+		if (arg.IsNull()) {
+			throw BinderException("xlsx_generate: the path, rows and columns must not be NULL");
+		}
+	}
+	result->file_path = StringValue::Get(input.inputs[0]);
+	const auto row_count = BigIntValue::Get(input.inputs[1]);
+	const auto column_count = BigIntValue::Get(input.inputs[2]);
+	if (column_count < 1 || column_count > static_cast<int64_t>(XLSX_MAX_CELL_COLS)) {
+		throw BinderException("xlsx_generate: the number of columns must be between 1 and %d", XLSX_MAX_CELL_COLS);
+	}
+	if (row_count < 0) {
+		throw BinderException("xlsx_generate: the number of rows must not be negative");
+	}
+	result->row_count = UnsafeNumericCast<idx_t>(row_count);
+
+	auto &options = result->options;
+	ParseGenerateOptions(options, input.named_parameters);
+
+	// The header, the rows and the gaps between them all have to fit in a sheet
+	const auto gap_count = options.row_gap && result->row_count ? (result->row_count - 1) / options.row_gap : 0;
+	const auto sheet_rows = result->row_count + gap_count + (options.header ? 1 : 0);
+	if (sheet_rows > XLSX_MAX_CELL_ROWS) {
+		throw BinderException("xlsx_generate: %d rows do not fit in a sheet, which has at most %d rows", sheet_rows,
+		                      XLSX_MAX_CELL_ROWS);
+	}
+
+	// Spread the string columns over the sheet, and the date columns over the numeric ones
+	const auto data_columns = UnsafeNumericCast<idx_t>(column_count) - 1;
+	const auto string_count = LossyNumericCast<idx_t>(std::round(double(data_columns) * options.string_columns));
+	const auto number_count = data_columns - string_count;
+	const auto date_count = LossyNumericCast<idx_t>(std::round(double(number_count) * options.date_columns));
+
+	result->columns.push_back(XLSXGenerateColumn::ROW_NUMBER);
+	idx_t number_idx = 0;
+	for (idx_t col_idx = 0; col_idx < data_columns; col_idx++) {
+		if (IsSpreadColumn(col_idx, string_count, data_columns)) {
+			result->columns.push_back(XLSXGenerateColumn::STRING);
+		} else if (IsSpreadColumn(number_idx++, date_count, number_count)) {
+			result->columns.push_back(XLSXGenerateColumn::DATE);
+		} else {
+			result->columns.push_back(XLSXGenerateColumn::NUMBER);
+		}
+	}
+
+	// There can't be more distinct strings than string cells. The default is capped, a larger explicit value is an
+	// error rather than a table of strings no cell refers to. Without any string cells the value doesn't matter, so
+	// that shapes without strings can be generated with the same options.
+	const auto string_cells = result->row_count * string_count;
+	if (options.cardinality > string_cells) {
+		if (string_cells > 0 && input.named_parameters.find("cardinality") != input.named_parameters.end()) {
+			throw BinderException("xlsx_generate: 'cardinality' must not exceed the number of string cells (%d)",
+			                      string_cells);
+		}
+		options.cardinality = MaxValue<idx_t>(string_cells, 1);
+	}
+
+	names.emplace_back("path");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("rows");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("columns");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("file_size");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+// Generate
+//------------------------------------------------------------------------------
+// Salts to draw independent values for the same cell
+static constexpr uint64_t SALT_VALUE = 0x5851F42D4C957F2DULL;
+static constexpr uint64_t SALT_EMPTY = 0x14057B7EF767814FULL;
+static constexpr uint64_t SALT_SHARED = 0x2545F4914F6CDD1DULL;
+
+static uint64_t MixHash(uint64_t x) {
+	// splitmix64
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+static uint64_t CellHash(uint64_t seed, uint64_t salt, idx_t row_idx, idx_t col_idx) {
+	return MixHash(MixHash(MixHash(seed ^ salt) ^ row_idx) ^ col_idx);
+}
+
+// Draws true with the given probability
+static bool CellChance(uint64_t hash, double probability) {
+	return static_cast<double>(hash >> 11) * (1.0 / 9007199254740992.0) < probability;
+}
+
+static void WriteJunkParts(XLXSWriter &writer, const XLSXGenerateOptions &options) {
+	if (options.junk_parts == 0) {
+		return;
+	}
+	auto &stream = writer.GetStream();
+	// Like media files, the parts need a content type for the package to be valid
+	writer.AddDefaultContentType("bin", "application/octet-stream");
+
+	// Random bytes, so that the parts don't compress away
+	vector<uint64_t> buffer(8192);
+	for (idx_t part_idx = 0; part_idx < options.junk_parts; part_idx++) {
+		stream.BeginFile("xl/media/junk" + std::to_string(part_idx + 1) + ".bin");
+		uint64_t state = MixHash(options.seed ^ part_idx);
+		for (idx_t written = 0; written < options.junk_size;) {
+			for (auto &word : buffer) {
+				word = state = MixHash(state);
+			}
+			const auto write_size = MinValue<idx_t>(options.junk_size - written, buffer.size() * sizeof(uint64_t));
+			stream.Write(reinterpret_cast<const char *>(buffer.data()), write_size);
+			written += write_size;
+		}
+		stream.EndFile();
+	}
+}
+
+static idx_t GenerateWorkbook(ClientContext &context, const XLSXGenerateData &data) {
+	const auto &options = data.options;
+	const auto column_count = data.columns.size();
+
+	XLXSWriter writer(context, data.file_path, XLSX_MAX_CELL_ROWS);
+	WriteJunkParts(writer, options);
+
+	// The writer only uses the types to tell numbers from strings
+	vector<string> column_names;
+	vector<LogicalType> column_types;
+	for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+		switch (data.columns[col_idx]) {
+		case XLSXGenerateColumn::ROW_NUMBER:
+			column_names.push_back("id");
+			column_types.push_back(LogicalType::UBIGINT);
+			break;
+		case XLSXGenerateColumn::NUMBER:
+			column_names.push_back("c" + std::to_string(col_idx));
+			column_types.push_back(LogicalType::DOUBLE);
+			break;
+		case XLSXGenerateColumn::DATE:
+			column_names.push_back("c" + std::to_string(col_idx));
+			column_types.push_back(LogicalType::DATE);
+			break;
+		case XLSXGenerateColumn::STRING:
+			column_names.push_back("c" + std::to_string(col_idx));
+			column_types.push_back(LogicalType::VARCHAR);
+			break;
+		}
+	}
+
+	// The strings are the same whether they are shared or inline, only added to the table if any are shared
+	vector<string> strings;
+	strings.reserve(options.cardinality);
+	for (idx_t string_idx = 0; string_idx < options.cardinality; string_idx++) {
+		strings.push_back("string " + std::to_string(string_idx));
+		if (options.shared_strings > 0) {
+			writer.AddSharedString(strings.back());
+		}
+	}
+
+	writer.BeginSheet(options.sheet_name, column_names, column_types);
+	if (options.header) {
+		writer.BeginRow();
+		for (const auto &name : column_names) {
+			writer.WriteInlineStringCell(string_t(name));
+		}
+		writer.EndRow();
+	}
+
+	string value;
+	for (idx_t row_idx = 0; row_idx < data.row_count; row_idx++) {
+		if (options.row_gap && row_idx && row_idx % options.row_gap == 0) {
+			writer.SkipRows(1);
+		}
+		writer.BeginRow();
+		for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+			const auto kind = data.columns[col_idx];
+			if (kind == XLSXGenerateColumn::ROW_NUMBER) {
+				value = std::to_string(row_idx + 1);
+				writer.WriteNumberCell(string_t(value));
+				continue;
+			}
+			const auto empty_hash = CellHash(options.seed, SALT_EMPTY, row_idx, col_idx);
+			if (options.sparsity > 0 && CellChance(empty_hash, options.sparsity)) {
+				writer.WriteEmptyCell();
+				continue;
+			}
+			const auto hash = CellHash(options.seed, SALT_VALUE, row_idx, col_idx);
+			switch (kind) {
+			case XLSXGenerateColumn::NUMBER: {
+				// A number with two decimals
+				const auto cents = hash % 10000000;
+				value = StringUtil::Format("%d.%02d", cents / 100, cents % 100);
+				writer.WriteNumberCell(string_t(value));
+				break;
+			}
+			case XLSXGenerateColumn::DATE:
+				// A day between 2000-01-01 and 2029-12-31
+				value = std::to_string(36526 + hash % 10958);
+				writer.WriteDateCell(string_t(value));
+				break;
+			case XLSXGenerateColumn::STRING: {
+				const auto string_idx = hash % options.cardinality;
+				if (CellChance(CellHash(options.seed, SALT_SHARED, row_idx, col_idx), options.shared_strings)) {
+					writer.WriteSharedStringCell(string_idx);
+				} else {
+					writer.WriteInlineStringCell(string_t(strings[string_idx]));
+				}
+				break;
+			}
+			default:
+				throw InternalException("xlsx_generate: unexpected column kind");
+			}
+		}
+		writer.EndRow();
+	}
+
+	writer.EndSheet();
+	writer.Finish();
+	return writer.GetStats().bytes_written;
+}
+
+//------------------------------------------------------------------------------
+// Execute
+//------------------------------------------------------------------------------
+class XLSXGenerateState final : public GlobalTableFunctionState {
+public:
+	bool finished = false;
+};
+
+static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<XLSXGenerateState>();
+}
+
+static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &data = input.bind_data->Cast<XLSXGenerateData>();
+	auto &state = input.global_state->Cast<XLSXGenerateState>();
+	if (state.finished) {
+		return;
+	}
+	state.finished = true;
+
+	const auto file_size = GenerateWorkbook(context, data);
+
+	output.SetValue(0, 0, Value(data.file_path));
+	output.SetValue(1, 0, Value::UBIGINT(data.row_count));
+	output.SetValue(2, 0, Value::UBIGINT(data.columns.size()));
+	output.SetValue(3, 0, Value::UBIGINT(file_size));
+	output.SetCardinality(1);
+}
+
+//------------------------------------------------------------------------------
+// Register
+//------------------------------------------------------------------------------
+void GenerateXLSX::Register(ExtensionLoader &loader) {
+	TableFunction generate("xlsx_generate", {LogicalType::VARCHAR, LogicalType::BIGINT, LogicalType::BIGINT},
+	                       Execute, Bind, InitGlobal);
+	generate.named_parameters["sheet"] = LogicalType::VARCHAR;
+	generate.named_parameters["header"] = LogicalType::BOOLEAN;
+	generate.named_parameters["string_columns"] = LogicalType::DOUBLE;
+	generate.named_parameters["shared_strings"] = LogicalType::DOUBLE;
+	generate.named_parameters["cardinality"] = LogicalType::UBIGINT;
+	generate.named_parameters["sparsity"] = LogicalType::DOUBLE;
+	generate.named_parameters["date_columns"] = LogicalType::DOUBLE;
+	generate.named_parameters["row_gap"] = LogicalType::UBIGINT;
+	generate.named_parameters["junk_parts"] = LogicalType::UBIGINT;
+	generate.named_parameters["junk_size"] = LogicalType::UBIGINT;
+	generate.named_parameters["seed"] = LogicalType::UBIGINT;
+	loader.RegisterFunction(generate);
+}
+
+} // namespace duckdb
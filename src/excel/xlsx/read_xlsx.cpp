@@ -1,15 +1,29 @@
 #include "xlsx/read_xlsx.hpp"
 
 #include "duckdb/common/helper.hpp"
+#include "duckdb/common/hive_partitioning.hpp"
+#include "duckdb/common/profiler.hpp"
 #include "duckdb/common/types/time.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/execution/partition_info.hpp"
 #include "duckdb/function/replacement_scan.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/main/query_profiler.hpp"
 #include "duckdb/main/query_result.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/parser/expression/constant_expression.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
 #include "duckdb/parser/tableref/table_function_ref.hpp"
+#include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/storage/buffer/buffer_handle.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/statistics/node_statistics.hpp"
 #include "xlsx/parsers/content_types_parser.hpp"
 #include "xlsx/parsers/relationship_parser.hpp"
 #include "xlsx/parsers/shared_strings_parser.hpp"
@@ -17,6 +31,8 @@
 #include "xlsx/parsers/workbook_parser.hpp"
 #include "xlsx/parsers/worksheet_parser.hpp"
 #include "xlsx/string_table.hpp"
+#include "xlsx/xlsb_util.hpp"
+#include "xlsx/xlsx_cache.hpp"
 #include "xlsx/xlsx_parts.hpp"
 #include "xlsx/xml_parser.hpp"
 #include "xlsx/xml_util.hpp"
@@ -168,32 +184,35 @@ static string XLSXUnescapeXMLEntities(const string &input) {
 //-------------------------------------------------------------------
 // Meta
 //-------------------------------------------------------------------
-static void ParseXLSXFileMeta(const unique_ptr<XLSXReadData> &result, ZipFileReader &reader) {
-
-	unordered_map<string, string> candidate_sheets;
-	string primary_sheet;
-
-	// Extract the content types to get the primary sheet
+// Parse the (name, path) of all the sheets in the workbook, in workbook order
+static vector<pair<string, string>> ParseWorkbookSheets(ZipFileReader &reader) {
+	// Extract the content types to make sure this is a valid xlsx file
 	if (!reader.TryOpenEntry("[Content_Types].xml")) {
 		throw BinderException("No [Content_Types].xml found in xlsx file");
 	}
 	const auto ctypes = ContentParser::ParseContentTypes(reader);
 	reader.CloseEntry();
 
-	if (!reader.TryOpenEntry("xl/workbook.xml")) {
+	// Binary workbooks (xlsb) list their sheets in records, the relationships are XML either way
+	vector<pair<string, string>> sheets;
+	auto is_binary = false;
+	if (reader.TryOpenEntry("xl/workbook.xml")) {
+		sheets = WorkBookParser::GetSheets(reader);
+	} else if (reader.TryOpenEntry("xl/workbook.bin")) {
+		sheets = WorkBookParser::GetBinarySheets(reader);
+		is_binary = true;
+	} else {
 		throw BinderException("No xl/workbook.xml found in xlsx file");
 	}
-	const auto sheets = WorkBookParser::GetSheets(reader);
 	reader.CloseEntry();
 
-	if (!reader.TryOpenEntry("xl/_rels/workbook.xml.rels")) {
-		throw BinderException("No xl/_rels/workbook.xml.rels found in xlsx file");
+	const auto rels_path = is_binary ? "xl/_rels/workbook.bin.rels" : "xl/_rels/workbook.xml.rels";
+	if (!reader.TryOpenEntry(rels_path)) {
+		throw BinderException("No %s found in xlsx file", rels_path);
 	}
 	const auto wbrels = RelParser::ParseRelations(reader);
 	reader.CloseEntry();
 
-	// TODO: Detect if we have a shared string table
-
 	// Resolve the sheet names to the paths
 	// Start by mapping rid to sheet path
 	unordered_map<string, string> rid_to_sheet_map;
@@ -204,49 +223,177 @@ static void ParseXLSXFileMeta(const unique_ptr<XLSXReadData> &result, ZipFileRea
 	}
 
 	// Now map name to rid and rid to sheet path
+	vector<pair<string, string>> result;
 	for (auto &sheet : sheets) {
 		const auto found = rid_to_sheet_map.find(sheet.second);
 		if (found != rid_to_sheet_map.end()) {
-
+			// The names in records are not escaped
+			auto name = is_binary ? sheet.first : XLSXUnescapeXMLEntities(sheet.first);
 			// Normalize everything to absolute paths
 			if (StringUtil::StartsWith(found->second, "/xl/")) {
-				candidate_sheets[XLSXUnescapeXMLEntities(sheet.first)] = found->second.substr(1);
+				result.emplace_back(std::move(name), found->second.substr(1));
 			} else {
-				candidate_sheets[XLSXUnescapeXMLEntities(sheet.first)] = "xl/" + found->second;
-			}
-
-			// Set the first sheet we find as the primary sheet
-			if (primary_sheet.empty()) {
-				primary_sheet = sheet.first;
+				result.emplace_back(std::move(name), "xl/" + found->second);
 			}
 		}
 	}
 
-	if (candidate_sheets.empty()) {
+	if (result.empty()) {
 		throw BinderException("No sheets found in xlsx file (is the file corrupt?)");
 	}
+	return result;
+}
 
-	// Default to the primary sheet if no option is given
-	auto &options = result->options;
-	if (options.sheet.empty()) {
-		options.sheet = primary_sheet;
+// A workbook opened during bind. Whatever was parsed or sniffed from the workbook before is taken from the
+// metadata cache, as long as the archive didn't change. The scan takes over the first workbook of a query, so that
+// it doesn't have to open the file and inflate the shared strings again.
+class XLSXOpenWorkbook {
+public:
+	XLSXOpenWorkbook(ClientContext &context, const string &file_path_p);
+
+	string file_path;
+	unique_ptr<ZipFileReader> archive;
+	hash_t fingerprint;
+
+	// The metadata of the workbook, and whether anything was added to it since it was looked up
+	XLSXWorkbookMetadata metadata;
+	bool metadata_changed = false;
+
+	mutex lock;
+	// Only loaded if any of the column names are shared strings
+	shared_ptr<const StringTable> strings;
+
+public:
+	// Get the (name, path) of all the sheets in the workbook, in workbook order
+	const vector<pair<string, string>> &GetSheets();
+	// Store the metadata in the cache, if anything was added to it
+	void CacheMetadata(ClientContext &context);
+};
+
+XLSXOpenWorkbook::XLSXOpenWorkbook(ClientContext &context, const string &file_path_p)
+    : file_path(file_path_p), archive(make_uniq<ZipFileReader>(context, file_path)),
+      fingerprint(archive->GetFingerprint()) {
+	const auto cache = XLSXMetadataCache::Get(context);
+	if (cache) {
+		const auto cached = cache->Lookup(file_path, fingerprint);
+		if (cached) {
+			metadata = *cached;
+		}
+	}
+}
+
+const vector<pair<string, string>> &XLSXOpenWorkbook::GetSheets() {
+	if (metadata.sheets.empty()) {
+		// The parts needed to bind are small and usually stored together, so read them all at once instead of
+		// issuing a read for each of them (which adds up on remote files)
+		archive->Prefetch({"[Content_Types].xml", "xl/workbook.xml", "xl/_rels/workbook.xml.rels", "xl/styles.xml",
+		                   XLSX_SHARED_STRINGS_ENTRY, "xl/workbook.bin", "xl/_rels/workbook.bin.rels", "xl/styles.bin",
+		                   XLSB_SHARED_STRINGS_ENTRY});
+		metadata.sheets = ParseWorkbookSheets(*archive);
+		metadata_changed = true;
+	}
+	return metadata.sheets;
+}
+
+void XLSXOpenWorkbook::CacheMetadata(ClientContext &context) {
+	if (!metadata_changed) {
+		return;
+	}
+	const auto cache = XLSXMetadataCache::Get(context);
+	if (cache) {
+		// Cache a copy, cached metadata is never modified
+		cache->Store(file_path, fingerprint, make_shared_ptr<XLSXWorkbookMetadata>(metadata));
+	}
+	metadata_changed = false;
+}
+
+// Excel does not allow '*' and '?' in sheet names, so we can use them as wildcards
+static bool IsSheetPattern(const string &sheet) {
+	return sheet.find_first_of("*?") != string::npos;
+}
+
+static bool MatchSheetPattern(const string &name, const string &pattern) {
+	idx_t name_idx = 0;
+	idx_t pattern_idx = 0;
+	// Where to backtrack to if a match after a '*' fails
+	auto star_idx = DConstants::INVALID_INDEX;
+	idx_t star_name_idx = 0;
+
+	while (name_idx < name.size()) {
+		if (pattern_idx < pattern.size() && (pattern[pattern_idx] == '?' || pattern[pattern_idx] == name[name_idx])) {
+			name_idx++;
+			pattern_idx++;
+		} else if (pattern_idx < pattern.size() && pattern[pattern_idx] == '*') {
+			star_idx = pattern_idx++;
+			star_name_idx = name_idx;
+		} else if (star_idx != DConstants::INVALID_INDEX) {
+			// Let the last '*' match one more character
+			pattern_idx = star_idx + 1;
+			name_idx = ++star_name_idx;
+		} else {
+			return false;
+		}
+	}
+	while (pattern_idx < pattern.size() && pattern[pattern_idx] == '*') {
+		pattern_idx++;
+	}
+	return pattern_idx == pattern.size();
+}
+
+// Resolve the sheets to read to their (name, path). Defaults to the first sheet if no sheets are given.
+static vector<pair<string, string>> ResolveSheetPaths(XLSXOpenWorkbook &workbook, const vector<string> &sheet_names) {
+	const auto &file_path = workbook.file_path;
+	const auto &sheets = workbook.GetSheets();
+	if (sheet_names.empty()) {
+		return {sheets.front()};
 	}
 
-	const auto found = candidate_sheets.find(XLSXUnescapeXMLEntities(options.sheet));
-	if (found == candidate_sheets.end()) {
-		// Throw a helpful error message
-		vector<string> all_sheets;
-		for (auto &sheet : candidate_sheets) {
-			all_sheets.push_back(sheet.first);
+	vector<pair<string, string>> result;
+	unordered_set<string> found_paths;
+	for (auto &sheet_name : sheet_names) {
+		const auto name = XLSXUnescapeXMLEntities(sheet_name);
+
+		if (IsSheetPattern(name)) {
+			for (auto &sheet : sheets) {
+				if (MatchSheetPattern(sheet.first, name) && found_paths.insert(sheet.second).second) {
+					result.push_back(sheet);
+				}
+			}
+			continue;
+		}
+
+		idx_t sheet_idx;
+		for (sheet_idx = 0; sheet_idx < sheets.size(); sheet_idx++) {
+			if (sheets[sheet_idx].first == name) {
+				break;
+			}
 		}
-		auto suggestions = StringUtil::CandidatesErrorMessage(all_sheets, options.sheet, "Did you mean");
-		throw BinderException("Sheet \"%s\" not found in xlsx file \"%s\"%s", options.sheet, result->file_path,
-		                      suggestions);
+		if (sheet_idx == sheets.size()) {
+			// Throw a helpful error message
+			vector<string> all_sheets;
+			for (auto &candidate : sheets) {
+				all_sheets.push_back(candidate.first);
+			}
+			auto suggestions = StringUtil::CandidatesErrorMessage(all_sheets, sheet_name, "Did you mean");
+			throw BinderException("Sheet \"%s\" not found in xlsx file \"%s\"%s", sheet_name, file_path, suggestions);
+		}
+		if (found_paths.insert(sheets[sheet_idx].second).second) {
+			result.push_back(sheets[sheet_idx]);
+		}
+	}
+
+	if (result.empty()) {
+		throw BinderException("No sheet matching \"%s\" found in xlsx file \"%s\"",
+		                      StringUtil::Join(sheet_names, "\", \""), file_path);
 	}
-	result->sheet_path = found->second;
+	return result;
 }
 
-static void ResolveColumnNames(vector<XLSXCell> &header_cells, ZipFileReader &archive) {
+// Resolve the shared strings in the header. If the strings are kept, the whole string table of the workbook is loaded
+// (so it can be handed over to the scan), otherwise only the strings in the header are looked up.
+static void ResolveColumnNames(ClientContext &context, vector<XLSXCell> &header_cells, XLSXOpenWorkbook &workbook,
+                               const bool keep_strings) {
+	auto &archive = *workbook.archive;
 
 	vector<idx_t> shared_string_ids;
 	vector<idx_t> shared_string_pos;
@@ -264,12 +411,35 @@ static void ResolveColumnNames(vector<XLSXCell> &header_cells, ZipFileReader &ar
 		return;
 	}
 
+	if (keep_strings) {
+		if (!workbook.strings) {
+			workbook.strings = XLSXSharedStringsCacheEntry::Load(context, workbook.file_path, archive);
+			if (!workbook.strings) {
+				throw BinderException("No shared strings found in xlsx file");
+			}
+		}
+
+		// Replace the shared strings with the resolved strings
+		auto &strings = *workbook.strings;
+		for (idx_t i = 0; i < shared_string_pos.size(); i++) {
+			if (shared_string_ids[i] >= strings.Size()) {
+				throw BinderException("Shared string %d not found in xlsx file", shared_string_ids[i]);
+			}
+			header_cells[shared_string_pos[i]].data = strings.Get(shared_string_ids[i]).GetString();
+		}
+		return;
+	}
+
 	// Resolve the shared strings
-	if (!archive.TryOpenEntry("xl/sharedStrings.xml")) {
-		throw BinderException("No shared strings found in xlsx file");
+	auto is_binary = false;
+	if (!archive.TryOpenEntry(XLSX_SHARED_STRINGS_ENTRY)) {
+		is_binary = true;
+		if (!archive.TryOpenEntry(XLSB_SHARED_STRINGS_ENTRY)) {
+			throw BinderException("No shared strings found in xlsx file");
+		}
 	}
 	SharedStringSearcher searcher(shared_string_ids);
-	searcher.ParseAll(archive);
+	searcher.ParseStrings(archive, is_binary);
 	archive.CloseEntry();
 
 	auto &shared_strings = searcher.GetResult();
@@ -282,11 +452,26 @@ static void ResolveColumnNames(vector<XLSXCell> &header_cells, ZipFileReader &ar
 
 void ReadXLSX::ParseOptions(XLSXReadOptions &options, const named_parameter_map_t &input) {
 
-	// Check which sheet to use, default to the primary sheet
+	// Check which sheets to use, default to the primary sheet
 	const auto sheet_opt = input.find("sheet");
 	if (sheet_opt != input.end()) {
-		// We need to escape all user-supplied strings when searching for them in the XML
-		options.sheet = EscapeXMLString(StringValue::Get(sheet_opt->second));
+		const auto &sheet_val = sheet_opt->second;
+		vector<Value> sheet_names;
+		if (sheet_val.type().id() == LogicalTypeId::LIST) {
+			sheet_names = ListValue::GetChildren(sheet_val);
+			if (sheet_names.empty()) {
+				throw BinderException("read_xlsx: the list of sheets must not be empty");
+			}
+		} else {
+			sheet_names.push_back(sheet_val);
+		}
+		for (auto &sheet_name : sheet_names) {
+			if (sheet_name.IsNull()) {
+				throw BinderException("read_xlsx: the sheet name must not be NULL");
+			}
+			// We need to escape all user-supplied strings when searching for them in the XML
+			options.sheets.push_back(EscapeXMLString(sheet_name.DefaultCastAs(LogicalType::VARCHAR).ToString()));
+		}
 	}
 
 	// Get the header mode
@@ -337,6 +522,18 @@ void ReadXLSX::ParseOptions(XLSXReadOptions &options, const named_parameter_map_
 		options.stop_at_empty = false;
 	}
 
+	const auto sample_size_opt = input.find("sample_size");
+	if (sample_size_opt != input.end()) {
+		const auto sample_size = BigIntValue::Get(sample_size_opt->second);
+		if (sample_size == -1) {
+			options.sample_size = NumericLimits<idx_t>::Maximum();
+		} else if (sample_size > 0) {
+			options.sample_size = NumericCast<idx_t>(sample_size);
+		} else {
+			throw BinderException("'sample_size' must be a positive number of rows, or -1 to sample all rows");
+		}
+	}
+
 	const auto stop_at_empty_op = input.find("stop_at_empty");
 	if (stop_at_empty_op != input.end()) {
 		options.stop_at_empty = BooleanValue::Get(stop_at_empty_op->second);
@@ -349,44 +546,109 @@ void ReadXLSX::ParseOptions(XLSXReadOptions &options, const named_parameter_map_
 	}
 }
 
-static void ParseStyleSheet(const unique_ptr<XLSXReadData> &result, ZipFileReader &archive) {
-	// Parse the styles (so we can handle dates)
-	if (archive.TryOpenEntry("xl/styles.xml")) {
-		XLSXStyleParser style_parser;
-		style_parser.ParseAll(archive);
-		result->style_sheet = XLSXStyleSheet(std::move(style_parser.cell_styles));
-		archive.CloseEntry();
+static void ParseStyleSheet(const unique_ptr<XLSXReadData> &result, XLSXOpenWorkbook &workbook) {
+	auto &metadata = workbook.metadata;
+	if (!metadata.has_style_sheet) {
+		// Parse the styles (so we can handle dates)
+		auto &archive = *workbook.archive;
+		if (archive.TryOpenEntry("xl/styles.xml")) {
+			XLSXStyleParser style_parser;
+			style_parser.ParseAll(archive);
+			metadata.style_sheet = XLSXStyleSheet(std::move(style_parser.cell_styles));
+			archive.CloseEntry();
+		} else if (archive.TryOpenEntry("xl/styles.bin")) {
+			XLSXStyleParser style_parser;
+			style_parser.ParseRecords(archive);
+			metadata.style_sheet = XLSXStyleSheet(std::move(style_parser.cell_styles));
+			archive.CloseEntry();
+		}
+		metadata.has_style_sheet = true;
+		workbook.metadata_changed = true;
 	}
+	result->style_sheet = metadata.style_sheet;
 }
 
-static void SniffRange(const unique_ptr<XLSXReadData> &result, ZipFileReader &archive) {
-	if (!archive.TryOpenEntry(result->sheet_path)) {
-		throw BinderException("Sheet '%s' not found in xlsx file", result->sheet_path);
+// The key of the sniffed schema of a sheet in the workbook metadata, which depends on the sniffing options
+static string GetSchemaKey(const string &sheet_path, const XLSXReadOptions &options) {
+	auto key = sheet_path;
+	key += "|" + std::to_string(static_cast<int>(options.header_mode));
+	key += "|" + std::to_string(static_cast<int>(options.default_cell_type));
+	key += options.all_varchar ? "|all_varchar" : "|";
+	// The sample ends at the first empty row when stopping at empty rows
+	key += options.stop_at_empty ? "|stop_at_empty" : "|";
+	key += "|" + std::to_string(options.sample_size);
+	if (options.has_explicit_range) {
+		const auto &range = options.range;
+		key += "|" + std::to_string(range.beg.row) + ":" + std::to_string(range.beg.col);
+		key += "|" + std::to_string(range.end.row) + ":" + std::to_string(range.end.col);
 	}
-	RangeSniffer range_sniffer;
-	range_sniffer.ParseAll(archive);
-	archive.CloseEntry();
-	result->options.range = range_sniffer.GetRange();
+	return key;
+}
+
+// Estimate the number of rows in the (sniffed) range from the dimension of the sheet, or else from the size of the
+// sheet and the size of the first data row
+static optional_idx EstimateSheetRows(const HeaderSniffer &sniffer, const XLSXCellRange &range,
+                                      const idx_t sheet_size) {
+	idx_t estimate;
+	if (sniffer.HasDimension()) {
+		const auto last_row = sniffer.GetDimension().end.row;
+		estimate = last_row >= range.beg.row ? last_row - range.beg.row + 1 : 0;
+	} else if (sniffer.GetSampledRowSize() > 0) {
+		estimate = sheet_size / sniffer.GetSampledRowSize();
+	} else {
+		return optional_idx();
+	}
+	return MinValue(estimate, range.Height());
 }
 
-static void SniffHeader(const unique_ptr<XLSXReadData> &result, ZipFileReader &archive) {
+// Returns the sniffed schema of the sheet
+static const XLSXSheetSchema &SniffHeader(ClientContext &context, const unique_ptr<XLSXReadData> &result,
+                                          XLSXOpenWorkbook &workbook, const bool keep_strings) {
 	auto &options = result->options;
 
-	if (!archive.TryOpenEntry(result->sheet_path)) {
+	// Check if the sheet was already sniffed with the same options
+	const auto schema_key = GetSchemaKey(result->sheet_path, options);
+	const auto cached = workbook.metadata.schemas.find(schema_key);
+	if (cached != workbook.metadata.schemas.end()) {
+		const auto &schema = cached->second;
+		options.range = schema.range;
+		result->column_names = schema.column_names;
+		result->return_types = schema.return_types;
+		result->source_types = schema.source_types;
+		return schema;
+	}
+
+	auto &archive = *workbook.archive;
+
+	// Only the first rows are sniffed, so stream the sheet instead of inflating all of it up front
+	if (!archive.TryOpenEntry(result->sheet_path, 0)) {
 		throw BinderException("Sheet '%s' not found in xlsx file", result->sheet_path);
 	}
-	HeaderSniffer sniffer(result->options.range, result->options.header_mode, result->options.has_explicit_range,
-	                      result->options.default_cell_type);
-	sniffer.ParseAll(archive);
+	const auto sheet_size = archive.GetEntryLen();
+	// Unless given, the range is sniffed in the same pass
+	auto sniffer = make_uniq<HeaderSniffer>(options.range, options.header_mode, options.has_explicit_range,
+	                                        options.default_cell_type, !options.has_explicit_range,
+	                                        result->style_sheet, options.all_varchar, options.sample_size,
+	                                        options.stop_at_empty);
+	if (IsXLSBPart(result->sheet_path)) {
+		sniffer->SetBinary();
+	}
+	sniffer->ParseSheet(archive);
 	archive.CloseEntry();
 
+	if (!sniffer->HasRange()) {
+		// None of the rows have any data, take the first row as it is instead of parsing the sheet again
+		sniffer->UseFirstRow();
+	}
+
 	// This is the range of actual data in the sheet (header not included)
-	options.range = sniffer.GetRange();
+	options.range = sniffer->GetRange();
 
-	auto &header_cells = sniffer.GetHeaderCells();
-	auto &column_cells = sniffer.GetColumnCells();
+	auto &header_cells = sniffer->GetHeaderCells();
+	auto &column_cells = sniffer->GetColumnCells();
 
-	if (column_cells.empty()) {
+	if (!sniffer->HasDataRow()) {
+		column_cells.clear();
 		if (header_cells.empty()) {
 			if (!options.has_explicit_range) {
 				throw BinderException("No rows found in xlsx file");
@@ -405,7 +667,7 @@ static void SniffHeader(const unique_ptr<XLSXReadData> &result, ZipFileReader &a
 	}
 
 	// Resolve any shared strings in the header
-	ResolveColumnNames(header_cells, archive);
+	ResolveColumnNames(context, header_cells, workbook, keep_strings);
 
 	// Set the return names
 	for (auto &cell : header_cells) {
@@ -413,54 +675,263 @@ static void SniffHeader(const unique_ptr<XLSXReadData> &result, ZipFileReader &a
 	}
 
 	// Convert excel types to duckdb types
-	for (auto &cell : column_cells) {
-		auto duckdb_type = cell.GetDuckDBType(result->options.all_varchar, result->style_sheet);
-		result->return_types.push_back(duckdb_type);
-		result->source_types.push_back(cell.type);
+	if (sniffer->HasDataRow()) {
+		// Widened to fit all the sampled rows
+		result->return_types = sniffer->GetColumnTypes();
+		result->source_types = sniffer->GetSourceTypes();
+	} else {
+		for (auto &cell : column_cells) {
+			auto duckdb_type = cell.GetDuckDBType(result->options.all_varchar, result->style_sheet);
+			result->return_types.push_back(duckdb_type);
+			result->source_types.push_back(cell.type);
+		}
 	}
+
+	XLSXSheetSchema schema;
+	schema.range = options.range;
+	schema.column_names = result->column_names;
+	schema.return_types = result->return_types;
+	schema.source_types = result->source_types;
+	schema.sheet_size = sheet_size;
+	schema.estimated_rows = EstimateSheetRows(*sniffer, options.range, sheet_size);
+	workbook.metadata_changed = true;
+	return workbook.metadata.schemas.emplace(schema_key, std::move(schema)).first->second;
 }
 
-void ReadXLSX::ResolveSheet(const unique_ptr<XLSXReadData> &result, ZipFileReader &archive) {
-	// Parse the meta
-	ParseXLSXFileMeta(result, archive);
+// Sniff the schema of the sheet at result->sheet_path
+static void SniffSheet(ClientContext &context, const unique_ptr<XLSXReadData> &result, XLSXOpenWorkbook &workbook,
+                       const bool keep_strings) {
 	// Parse the style sheet
-	ParseStyleSheet(result, archive);
-	if (!result->options.has_explicit_range) {
-		// Sniff content range if required
-		SniffRange(result, archive);
+	ParseStyleSheet(result, workbook);
+	// Sniff the range (if required) and the header
+	const auto &schema = SniffHeader(context, result, workbook, keep_strings);
+
+	XLSXSheetLayout layout;
+	layout.range = result->options.range;
+	layout.source_types = result->source_types;
+	layout.sheet_size = schema.sheet_size;
+	layout.estimated_rows = schema.estimated_rows;
+	for (idx_t col_idx = 0; col_idx < result->source_types.size(); col_idx++) {
+		layout.column_map.push_back(col_idx);
+	}
+	result->layouts.clear();
+	result->layouts.push_back(std::move(layout));
+	result->sheet_column_count = result->return_types.size();
+}
+
+void ReadXLSX::ResolveSheet(ClientContext &context, const unique_ptr<XLSXReadData> &result) {
+	auto workbook = make_shared_ptr<XLSXOpenWorkbook>(context, result->file_path);
+
+	// Resolve the sheets to read, the schema is sniffed from the first one
+	const auto sheets = ResolveSheetPaths(*workbook, result->options.sheets);
+	result->sheet_path = sheets.front().second;
+	SniffSheet(context, result, *workbook, true);
+	workbook->CacheMetadata(context);
+
+	// Unless told otherwise, this is the only file to scan
+	result->files.clear();
+	result->files.push_back(result->file_path);
+	result->sheets.clear();
+	for (auto &sheet : sheets) {
+		result->sheets.emplace_back(0, sheet.first, sheet.second);
 	}
-	// Sniff header
-	SniffHeader(result, archive);
+	result->open_workbook = std::move(workbook);
 }
 
 //-------------------------------------------------------------------
 // Bind
 //-------------------------------------------------------------------
+// The schema of a sheet sniffed during bind, and its cleaned up column names
+struct XLSXSniffedSheet {
+	unique_ptr<XLSXReadData> data;
+	vector<string> names;
+};
+
+// Sniff every sheet but the first one, which has already been sniffed
+static vector<XLSXSniffedSheet> SniffOtherSheets(ClientContext &context, const XLSXReadOptions &options,
+                                                 const XLSXReadData &result) {
+	vector<XLSXSniffedSheet> sniffed;
+	auto &first_workbook = *result.open_workbook;
+	unique_ptr<XLSXOpenWorkbook> file_workbook;
+	auto file_workbook_idx = DConstants::INVALID_INDEX;
+	for (idx_t sheet_idx = 1; sheet_idx < result.sheets.size(); sheet_idx++) {
+		const auto &sheet = result.sheets[sheet_idx];
+		// The first file is still open from sniffing its first sheet
+		const auto is_first_file = sheet.file_idx == 0;
+		if (!is_first_file && sheet.file_idx != file_workbook_idx) {
+			if (file_workbook) {
+				file_workbook->CacheMetadata(context);
+			}
+			file_workbook_idx = sheet.file_idx;
+			file_workbook = make_uniq<XLSXOpenWorkbook>(context, result.files[file_workbook_idx]);
+		}
+		auto &workbook = is_first_file ? first_workbook : *file_workbook;
+
+		auto sheet_data = make_uniq<XLSXReadData>();
+		sheet_data->file_path = result.files[sheet.file_idx];
+		sheet_data->sheet_path = sheet.sheet_path;
+		sheet_data->options = options;
+		SniffSheet(context, sheet_data, workbook, is_first_file);
+
+		auto sheet_names = sheet_data->column_names;
+		CleanColumnNames(sheet_names, options.normalize_names);
+		QueryResult::DeduplicateColumns(sheet_names);
+		sniffed.push_back({std::move(sheet_data), std::move(sheet_names)});
+	}
+
+	first_workbook.CacheMetadata(context);
+	if (file_workbook) {
+		file_workbook->CacheMetadata(context);
+	}
+	return sniffed;
+}
+
+static string FormatColumnNames(const vector<string> &names) {
+	string result;
+	for (idx_t col_idx = 0; col_idx < names.size(); col_idx++) {
+		if (col_idx > 0) {
+			result += ", ";
+		}
+		result += "\"" + names[col_idx] + "\"";
+	}
+	return result;
+}
+
+// Without union_by_name every sheet is read with the layout of the first one, so their headers have to match
+static void VerifySheetHeaders(ClientContext &context, const XLSXReadOptions &options, const XLSXReadData &result,
+                               const vector<string> &names) {
+	const auto sniffed = SniffOtherSheets(context, options, result);
+	for (idx_t sheet_idx = 1; sheet_idx < result.sheets.size(); sheet_idx++) {
+		const auto &sheet_names = sniffed[sheet_idx - 1].names;
+		auto is_match = sheet_names.size() == names.size();
+		for (idx_t col_idx = 0; is_match && col_idx < names.size(); col_idx++) {
+			is_match = StringUtil::CIEquals(sheet_names[col_idx], names[col_idx]);
+		}
+		if (is_match) {
+			continue;
+		}
+		const auto &sheet = result.sheets[sheet_idx];
+		throw BinderException("Schema mismatch between sheet \"%s\" of \"%s\" and sheet \"%s\" of \"%s\"\n"
+		                      "Expected columns: %s\nFound columns: %s\n\nPossible solutions:\n"
+		                      "* Enable the union_by_name = true option to combine the sheets by column name\n"
+		                      "* Read the sheets separately",
+		                      sheet.sheet_name, result.files[sheet.file_idx], result.sheets[0].sheet_name,
+		                      result.file_path, FormatColumnNames(names), FormatColumnNames(sheet_names));
+	}
+}
+
+static void BindUnionByName(ClientContext &context, const XLSXReadOptions &options, XLSXReadData &result,
+                            vector<LogicalType> &return_types, vector<string> &names) {
+	case_insensitive_map_t<idx_t> name_map;
+	for (idx_t col_idx = 0; col_idx < names.size(); col_idx++) {
+		name_map[names[col_idx]] = col_idx;
+	}
+
+	// The cell types the result columns were sniffed from, the types of a column found in different sheets are widened
+	// the same way as the types of different rows of a sheet
+	auto source_types = result.source_types;
+
+	// Merge the columns of the other sheets by name
+	for (auto &sheet : SniffOtherSheets(context, options, result)) {
+		const auto &sheet_names = sheet.names;
+		auto layout = std::move(sheet.data->layouts[0]);
+		for (idx_t col_idx = 0; col_idx < sheet_names.size(); col_idx++) {
+			const auto &sheet_type = sheet.data->return_types[col_idx];
+			const auto entry = name_map.find(sheet_names[col_idx]);
+			if (entry == name_map.end()) {
+				// New column, add it to the result
+				const auto result_idx = names.size();
+				name_map[sheet_names[col_idx]] = result_idx;
+				names.push_back(sheet_names[col_idx]);
+				return_types.push_back(sheet_type);
+				source_types.push_back(layout.source_types[col_idx]);
+				layout.column_map[col_idx] = result_idx;
+			} else {
+				auto &result_type = return_types[entry->second];
+				result_type = WidenSniffedType(result_type, source_types[entry->second], sheet_type,
+				                               layout.source_types[col_idx]);
+				layout.column_map[col_idx] = entry->second;
+			}
+		}
+		result.layouts.push_back(std::move(layout));
+	}
+}
+
+// Add the columns that are constant per file (filename, hive partitions), and get their values for every file
+static void BindFileConstants(ClientContext &context, XLSXReadData &result, vector<LogicalType> &return_types,
+                              vector<string> &names) {
+	const auto &options = result.file_options;
+	const auto &reader_bind = result.reader_bind;
+	result.multi_file_reader->BindOptions(result.file_options, *result.file_list, return_types, names,
+	                                      result.reader_bind);
+
+	// The multi file reader lets a hive partition replace a column of the same name, but sheet columns are always
+	// read from the sheet
+	for (auto &partition : reader_bind.hive_partitioning_indexes) {
+		if (partition.index < result.sheet_column_count) {
+			throw BinderException(
+			    "Option hive_partitioning adds column \"%s\", but a column with this name is also in the file",
+			    partition.value);
+		}
+	}
+
+	const auto constant_count = names.size() - result.sheet_column_count;
+	result.file_constants.resize(result.files.size());
+	for (idx_t file_idx = 0; file_idx < result.files.size(); file_idx++) {
+		const auto &file = result.files[file_idx];
+		auto &constants = result.file_constants[file_idx];
+		constants.resize(constant_count);
+		if (reader_bind.filename_idx != DConstants::INVALID_INDEX) {
+			constants[reader_bind.filename_idx - result.sheet_column_count] = Value(file);
+		}
+		if (reader_bind.hive_partitioning_indexes.empty()) {
+			continue;
+		}
+		// Every file has the same partition keys, the multi file reader checked that
+		const auto partitions = HivePartitioning::Parse(file);
+		for (auto &partition : reader_bind.hive_partitioning_indexes) {
+			const auto entry = partitions.find(partition.value);
+			D_ASSERT(entry != partitions.end());
+			constants[partition.index - result.sheet_column_count] =
+			    options.GetHivePartitionValue(entry->second, partition.value, context);
+		}
+	}
+}
+
 static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
                                      vector<LogicalType> &return_types, vector<string> &names) {
 	auto result = make_uniq<XLSXReadData>();
-	// Get the file name
-	const auto file_path = StringValue::Get(input.inputs[0]);
 
-	// Glob here so that we auto load any required extension filesystems
-	auto &fs = FileSystem::GetFileSystem(context);
-	auto files = fs.GlobFiles(file_path, FileGlobOptions::ALLOW_EMPTY);
-	if (files.empty()) {
-		// Use our own error message to be less confusing
-		throw IOException("Cannot open file \"%s\": No such file or directory", file_path);
-	}
+	// Get the files to read. Glob here so that we auto load any required extension filesystems.
+	result->multi_file_reader = MultiFileReader::Create(input.table_function);
+	result->file_list = result->multi_file_reader->CreateFileList(context, input.inputs[0]);
 
-	// We dont support multi-file-reading, so just take the first file for now
-	result->file_path = files.front().path;
+	// Parse the options, the multi file reader picks the ones it handles
+	for (auto &param : input.named_parameters) {
+		result->multi_file_reader->ParseOption(param.first, param.second, result->file_options, context);
+	}
+	result->file_options.AutoDetectHivePartitioning(*result->file_list, context);
+	ReadXLSX::ParseOptions(result->options, input.named_parameters);
 
-	// Open the archive
-	ZipFileReader archive(context, result->file_path);
+	vector<string> files;
+	for (auto &file : result->file_list->GetAllFiles()) {
+		files.push_back(file.path);
+	}
 
-	// Parse the options
-	ReadXLSX::ParseOptions(result->options, input.named_parameters);
+	// Keep the options as given, the sheet resolution modifies them
+	const auto options = result->options;
 
-	// Resolve the sheet
-	ReadXLSX::ResolveSheet(result, archive);
+	// Resolve the sheets of the first file. Unless we union by name, all sheets share the schema of its first sheet
+	result->file_path = files.front();
+	ReadXLSX::ResolveSheet(context, result);
+	for (idx_t file_idx = 1; file_idx < files.size(); file_idx++) {
+		XLSXOpenWorkbook workbook(context, files[file_idx]);
+		for (auto &sheet : ResolveSheetPaths(workbook, options.sheets)) {
+			result->sheets.emplace_back(file_idx, sheet.first, sheet.second);
+		}
+		workbook.CacheMetadata(context);
+	}
+	result->files = std::move(files);
 
 	return_types = result->return_types;
 	names = result->column_names;
@@ -471,219 +942,1637 @@ static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindIn
 	// Deduplicate column names
 	QueryResult::DeduplicateColumns(names);
 
-	return std::move(result);
-}
-
-//-------------------------------------------------------------------
-// Global State
-//-------------------------------------------------------------------
-class XLSXGlobalState final : public GlobalTableFunctionState {
-public:
-	explicit XLSXGlobalState(ClientContext &context, const string &file_name, const XLSXCellRange &range,
-	                         bool stop_at_empty)
-	    : archive(context, file_name), strings(BufferAllocator::Get(context)),
-	      parser(context, range, strings, stop_at_empty),
-	      buffer(make_unsafe_uniq_array_uninitialized<char>(BUFFER_SIZE)) {
-
-		cast_vec.Initialize(context, {LogicalType::DOUBLE});
+	if (result->sheets.size() > 1) {
+		if (result->file_options.union_by_name) {
+			BindUnionByName(context, options, *result, return_types, names);
+		} else {
+			VerifySheetHeaders(context, options, *result, names);
+		}
 	}
 
-	ZipFileReader archive;
-	StringTable strings;
-	SheetParser parser;
-	unsafe_unique_array<char> buffer;
-
-	XMLParseResult status = XMLParseResult::OK;
-
-	string cast_err;
-	DataChunk cast_vec;
-
-	atomic<idx_t> stream_pos = {0};
-	idx_t stream_len = 0;
-
-	// 8kb buffer
-	static constexpr auto BUFFER_SIZE = 8096;
-};
+	// Everything after this is constant per file
+	result->sheet_column_count = return_types.size();
+	BindFileConstants(context, *result, return_types, names);
 
-static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext &context, TableFunctionInitInput &input) {
-	auto &data = input.bind_data->Cast<XLSXReadData>();
-	auto &options = data.options;
-	auto state = make_uniq<XLSXGlobalState>(context, data.file_path, data.options.range, options.stop_at_empty);
+	result->return_types = return_types;
+	result->column_names = names;
 
-	// Check if there is a string table. If there is, extract it
-	if (state->archive.TryOpenEntry("xl/sharedStrings.xml")) {
-		SharedStringParser::ParseStringTable(state->archive, state->strings);
-		state->archive.CloseEntry();
-	}
+	return std::move(result);
+}
 
-	// Open the main sheet for reading
-	if (!state->archive.TryOpenEntry(data.sheet_path)) {
-		// This should never happen, we've already checked this in the bind function
-		throw InvalidInputException("Sheet '%s' not found in xlsx file", data.sheet_path);
+// Sheets that share the layout of the first sheet are assumed to have as many rows as it does
+static unique_ptr<NodeStatistics> Cardinality(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &data = bind_data_p->Cast<XLSXReadData>();
+	idx_t estimate = 0;
+	for (idx_t sheet_idx = 0; sheet_idx < data.sheets.size(); sheet_idx++) {
+		const auto &estimated_rows = data.GetLayout(sheet_idx).estimated_rows;
+		if (!estimated_rows.IsValid()) {
+			return nullptr;
+		}
+		estimate += estimated_rows.GetIndex();
 	}
+	return make_uniq<NodeStatistics>(estimate);
+}
 
-	// Set the progress counters
-	state->stream_len = state->archive.GetEntryLen();
-	state->stream_pos = 0;
-
-	return std::move(state);
+// The virtual columns of read_xlsx
+static constexpr column_t XLSX_COLUMN_IDENTIFIER_SHEET_NAME = VIRTUAL_COLUMN_START;
+static constexpr column_t XLSX_COLUMN_IDENTIFIER_SHEET_ROW = VIRTUAL_COLUMN_START + 1;
+static constexpr column_t XLSX_COLUMN_IDENTIFIER_FILENAME = VIRTUAL_COLUMN_START + 2;
+
+static virtual_column_map_t GetVirtualColumns(ClientContext &context, optional_ptr<FunctionData> bind_data) {
+	virtual_column_map_t result;
+	result.insert(make_pair(XLSX_COLUMN_IDENTIFIER_SHEET_NAME, TableColumn("sheet_name", LogicalType::VARCHAR)));
+	// The row number of every row in its sheet, as shown by excel
+	result.insert(make_pair(XLSX_COLUMN_IDENTIFIER_SHEET_ROW, TableColumn("sheet_row", LogicalType::BIGINT)));
+	result.insert(make_pair(XLSX_COLUMN_IDENTIFIER_FILENAME, TableColumn("filename", LogicalType::VARCHAR)));
+	// Lets queries that don't need any column (e.g. COUNT(*)) skip the data of every cell
+	result.insert(make_pair(COLUMN_IDENTIFIER_EMPTY, TableColumn("", LogicalType::BOOLEAN)));
+	return result;
 }
 
 //-------------------------------------------------------------------
-// Execute
+// Filter Pushdown
 //-------------------------------------------------------------------
+// Filters on the filename and hive partition columns prune the files
+// to scan. Filters on sheet_row are used to narrow the rows of the
+// range that are read, so that the scan can start at the first
+// matching row and stop after the last one. The filters on sheet_row
+// themselves are left in place.
+//-------------------------------------------------------------------
+// Drop the files (and their sheets) that can't match the filters
+static void PruneFiles(ClientContext &context, LogicalGet &get, XLSXReadData &data,
+                       vector<unique_ptr<Expression>> &filters) {
+	MultiFilePushdownInfo info(get);
+	auto pruned_list =
+	    data.multi_file_reader->ComplexFilterPushdown(context, *data.file_list, data.file_options, info, filters);
+	if (!pruned_list) {
+		return;
+	}
 
-int64_t ExcelToEpochUS(const double serial) {
-	// Convert to microseconds since epoch
-	static constexpr auto SECONDS_PER_DAY = 86400UL;
-	static constexpr auto MICROSECONDS_PER_SECOND = 1000000UL;
-	static constexpr auto DAYS_BETWEEN_1900_AND_1970 = 25569UL;
-
-	// Excel serial is days since 1900-01-01
-	const auto serial_days = serial;
-	auto serial_secs = serial_days * SECONDS_PER_DAY;
-
-	if (std::fabs(serial_secs - std::round(serial_secs)) < 1e-3) {
-		serial_secs = std::round(serial_secs);
+	// The files that are left keep their order, map them to their new index
+	vector<idx_t> file_map(data.files.size(), DConstants::INVALID_INDEX);
+	vector<string> files;
+	vector<vector<Value>> file_constants;
+	idx_t file_idx = 0;
+	for (auto &file : pruned_list->GetAllFiles()) {
+		while (file_idx < data.files.size() && data.files[file_idx] != file.path) {
+			file_idx++;
+		}
+		if (file_idx == data.files.size()) {
+			throw InternalException("read_xlsx: pruned file \"%s\" is not one of the files to scan", file.path);
+		}
+		file_map[file_idx] = files.size();
+		files.push_back(std::move(data.files[file_idx]));
+		file_constants.push_back(std::move(data.file_constants[file_idx]));
+		file_idx++;
 	}
 
-	const auto epoch_secs = serial_secs - (DAYS_BETWEEN_1900_AND_1970 * SECONDS_PER_DAY);
-	const auto epoch_micros = epoch_secs * MICROSECONDS_PER_SECOND;
+	// Keep the sheets of the files that are left, and their layouts unless all sheets share the same one
+	const auto has_sheet_layouts = data.layouts.size() > 1;
+	vector<XLSXSheetSource> sheets;
+	vector<XLSXSheetLayout> layouts;
+	for (idx_t sheet_idx = 0; sheet_idx < data.sheets.size(); sheet_idx++) {
+		auto &sheet = data.sheets[sheet_idx];
+		if (file_map[sheet.file_idx] == DConstants::INVALID_INDEX) {
+			continue;
+		}
+		sheets.emplace_back(file_map[sheet.file_idx], std::move(sheet.sheet_name), std::move(sheet.sheet_path));
+		if (has_sheet_layouts) {
+			layouts.push_back(std::move(data.layouts[sheet_idx]));
+		}
+	}
 
-	// Clamp to the range. Theres not much we can do if the value is out of range
-	if (epoch_micros <= static_cast<double>(NumericLimits<int64_t>::Minimum())) {
-		return NumericLimits<int64_t>::Minimum();
+	// The first file as opened during bind can only be handed over to the scan if it is still the first file
+	if (file_map[0] != 0) {
+		data.open_workbook = nullptr;
 	}
-	if (epoch_micros >= static_cast<double>(NumericLimits<int64_t>::Maximum())) {
-		return NumericLimits<int64_t>::Maximum();
+	data.files = std::move(files);
+	data.file_constants = std::move(file_constants);
+	data.sheets = std::move(sheets);
+	if (has_sheet_layouts) {
+		data.layouts = std::move(layouts);
 	}
-
-	return static_cast<int64_t>(epoch_micros);
+	data.file_list = std::move(pruned_list);
 }
 
-static void TryCastFromString(XLSXGlobalState &state, bool ignore_errors, const idx_t col_idx, ClientContext &context,
-                              Vector &target_col) {
-
-	auto &chunk = state.parser.GetChunk();
-	auto &source_col = chunk.data[col_idx];
-	const auto row_count = chunk.size();
+// Narrow the (inclusive) bounds of sheet_row by a comparison against a constant. Returns false if it is not one.
+static bool TryNarrowSheetRow(const LogicalGet &get, ExpressionType comparison, const Expression &column,
+                              const Expression &constant, idx_t &min_row, idx_t &max_row) {
+	if (column.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF ||
+	    constant.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+		return false;
+	}
+	const auto &colref = column.Cast<BoundColumnRefExpression>();
+	const auto &column_ids = get.GetColumnIds();
+	if (colref.binding.table_index != get.table_index || colref.binding.column_index >= column_ids.size() ||
+	    column_ids[colref.binding.column_index].GetPrimaryIndex() != XLSX_COLUMN_IDENTIFIER_SHEET_ROW) {
+		return false;
+	}
+	const auto &value = constant.Cast<BoundConstantExpression>().value;
+	if (value.IsNull() || !value.type().IsIntegral()) {
+		return false;
+	}
+	const auto row = value.DefaultCastAs(LogicalType::BIGINT).GetValue<int64_t>();
+	// Rows are numbered from 1, the comparisons are clamped to that
+	const auto at_least = [&](int64_t bound) {
+		min_row = MaxValue(min_row, bound < 1 ? 1 : UnsafeNumericCast<idx_t>(bound));
+	};
+	const auto at_most = [&](int64_t bound) {
+		max_row = MinValue(max_row, bound < 0 ? 0 : UnsafeNumericCast<idx_t>(bound));
+	};
+	switch (comparison) {
+	case ExpressionType::COMPARE_EQUAL:
+		at_least(row);
+		at_most(row);
+		return true;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		at_least(row == NumericLimits<int64_t>::Maximum() ? row : row + 1);
+		return true;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		at_least(row);
+		return true;
+	case ExpressionType::COMPARE_LESSTHAN:
+		at_most(row < 1 ? 0 : row - 1);
+		return true;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		at_most(row);
+		return true;
+	default:
+		return false;
+	}
+}
 
-	const auto ok = VectorOperations::TryCast(context, source_col, target_col, row_count, &state.cast_err);
-	if (!ok && !ignore_errors) {
-		// Figure out which cell failed
-		const auto &source_validity = FlatVector::Validity(source_col);
-		const auto &target_validity = FlatVector::Validity(target_col);
-		for (idx_t row_idx = 0; row_idx < row_count; row_idx++) {
-			if (source_validity.RowIsValid(row_idx) != target_validity.RowIsValid(row_idx)) {
-				// If the string is empty, allow it to be cast to NULL
-				if (!FlatVector::GetData<string_t>(source_col)[row_idx].Empty()) {
-					const auto cell_name = state.parser.GetCellName(row_idx, col_idx);
-					throw InvalidInputException("read_xlsx: Failed to parse cell '%s': %s", cell_name, state.cast_err);
-				}
+static void PushdownComplexFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+                                  vector<unique_ptr<Expression>> &filters) {
+	auto &data = bind_data_p->Cast<XLSXReadData>();
+
+	PruneFiles(context, get, data, filters);
+
+	idx_t min_row = 1;
+	idx_t max_row = NumericLimits<idx_t>::Maximum() - 1;
+	auto is_narrowed = false;
+	for (auto &filter : filters) {
+		if (filter->GetExpressionClass() == ExpressionClass::BOUND_COMPARISON) {
+			auto &comparison = filter->Cast<BoundComparisonExpression>();
+			if (TryNarrowSheetRow(get, comparison.GetExpressionType(), *comparison.left, *comparison.right, min_row,
+			                      max_row) ||
+			    TryNarrowSheetRow(get, FlipComparisonExpression(comparison.GetExpressionType()), *comparison.right,
+			                      *comparison.left, min_row, max_row)) {
+				is_narrowed = true;
+			}
+		} else if (filter->GetExpressionClass() == ExpressionClass::BOUND_BETWEEN) {
+			auto &between = filter->Cast<BoundBetweenExpression>();
+			const auto lower = between.LowerComparisonType();
+			const auto upper = between.UpperComparisonType();
+			// Only narrow by both bounds, so that neither is skipped if the other one isn't a constant
+			idx_t between_min = min_row;
+			idx_t between_max = max_row;
+			if (TryNarrowSheetRow(get, lower, *between.input, *between.lower, between_min, between_max) &&
+			    TryNarrowSheetRow(get, upper, *between.input, *between.upper, between_min, between_max)) {
+				min_row = between_min;
+				max_row = between_max;
+				is_narrowed = true;
 			}
 		}
 	}
-}
-
-static void TryCastTime(XLSXGlobalState &state, bool ignore_errors, const idx_t col_idx, ClientContext &context,
-                        Vector &target_col) {
-	// First cast it to a double
-	TryCastFromString(state, ignore_errors, col_idx, context, state.cast_vec.data[0]);
+	if (!is_narrowed) {
+		return;
+	}
 
-	// Then convert the double to a time
-	const auto row_count = state.parser.GetChunk().size();
-	UnaryExecutor::Execute<double, dtime_t>(state.cast_vec.data[0], target_col, row_count, [&](const double &input) {
-		const auto epoch_us = ExcelToEpochUS(input);
-		const auto stamp = Timestamp::FromEpochMicroSeconds(epoch_us);
-		return Timestamp::GetTime(stamp);
-	});
+	for (auto &layout : data.layouts) {
+		auto &range = layout.range;
+		// Until the first empty row, every row has to be read to know whether the scan goes on
+		if (!data.options.stop_at_empty) {
+			range.beg.row = MaxValue(range.beg.row, min_row);
+		}
+		range.end.row = MaxValue(range.beg.row, MinValue(range.end.row, max_row + 1));
+		if (layout.estimated_rows.IsValid()) {
+			layout.estimated_rows = MinValue(layout.estimated_rows.GetIndex(), range.Height());
+		}
+	}
 }
 
-static void TryCastDate(XLSXGlobalState &state, bool ignore_errors, const idx_t col_idx, ClientContext &context,
-                        Vector &target_col) {
-	// First cast it to a double
-	TryCastFromString(state, ignore_errors, col_idx, context, state.cast_vec.data[0]);
-
-	// Then convert the double to a date
-	const auto row_count = state.parser.GetChunk().size();
-	UnaryExecutor::Execute<double, date_t>(state.cast_vec.data[0], target_col, row_count, [&](const double &input) {
-		const auto epoch_us = ExcelToEpochUS(input);
-		const auto stamp = Timestamp::FromEpochMicroSeconds(epoch_us);
-		return Timestamp::GetDate(stamp);
-	});
+//-------------------------------------------------------------------
+// Sheet Segments
+//-------------------------------------------------------------------
+// Large sheets are inflated into memory once and split into segments
+// at row boundaries, so that multiple threads can parse them at the
+// same time. Every segment covers a consecutive range of sheet rows.
+//-------------------------------------------------------------------
+// The (uncompressed) size of a sheet segment
+static constexpr idx_t XLSX_SEGMENT_SIZE = 4ULL * 1024 * 1024;
+// Every sheet and segment is a batch of the scan, numbered in sheet order and then segment order, so that the rows
+// can be put back in order. This is more segments than a sheet can have (4TB of sheet data).
+static constexpr idx_t XLSX_SHEET_BATCHES = 1ULL << 20;
+
+static idx_t GetBatchIndex(const idx_t sheet_idx, const idx_t segment_idx) {
+	return sheet_idx * XLSX_SHEET_BATCHES + segment_idx;
 }
 
-static void TryCastTimestamp(XLSXGlobalState &state, bool ignore_errors, const idx_t col_idx, ClientContext &context,
-                             Vector &target_col) {
-	// First cast it to a double
-	TryCastFromString(state, ignore_errors, col_idx, context, state.cast_vec.data[0]);
+class XLSXSheetSegment {
+public:
+	// The byte range of the rows in the staged sheet (or in the sheet entry, if split at checkpoints)
+	idx_t beg_pos;
+	idx_t end_pos;
+	// The range of sheet rows to read from this segment (end exclusive)
+	idx_t beg_row;
+	idx_t end_row;
+	// The row number of the first row in the segment
+	idx_t first_row;
+	// If split at checkpoints, the checkpoint to start inflating at (none for the first segment)
+	idx_t checkpoint_idx = DConstants::INVALID_INDEX;
+};
 
-	// Then convert the double to a timestamp
-	const auto row_count = state.parser.GetChunk().size();
-	UnaryExecutor::Execute<double, timestamp_t>(state.cast_vec.data[0], target_col, row_count,
-	                                            [&](const double &input) {
-		                                            const auto epoch_us = ExcelToEpochUS(input);
-		                                            return Timestamp::FromEpochMicroSeconds(epoch_us);
-	                                            });
+// The segments are wrapped in a sheetData element, so that they can be parsed as a sheet on their own
+static constexpr char XLSX_SEGMENT_PREFIX[] = "<sheetData>";
+static constexpr char XLSX_SEGMENT_SUFFIX[] = "</sheetData>";
+
+// Find the next start tag with the given name. Returns nullptr if there is none.
+// This does not understand comments or CDATA sections, which do not appear in sheet data written by excel.
+static const char *FindStartTag(const char *ptr, const char *end, const char *tag) {
+	while (ptr < end) {
+		ptr = static_cast<const char *>(memchr(ptr, '<', NumericCast<size_t>(end - ptr)));
+		if (!ptr) {
+			return nullptr;
+		}
+		const auto name_beg = ptr + 1;
+		if (MatchXMLName(name_beg, SkipXMLName(name_beg, end), tag)) {
+			return ptr;
+		}
+		ptr++;
+	}
+	return nullptr;
 }
 
-static void Execute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-	auto &bind_data = data.bind_data->Cast<XLSXReadData>();
-	auto &options = bind_data.options;
-	auto &gstate = data.global_state->Cast<XLSXGlobalState>();
-	const auto buffer = gstate.buffer.get();
-
-	auto &stream = gstate.archive;
-	auto &parser = gstate.parser;
-	auto &status = gstate.status;
-
-	// Ready the chunk
-	auto &chunk = parser.GetChunk();
-	chunk.Reset();
-
-	while (chunk.size() != STANDARD_VECTOR_SIZE) {
-		if (status == XMLParseResult::SUSPENDED) {
-			if (parser.FoundSkippedRow()) {
-				if (options.stop_at_empty) {
-					status = XMLParseResult::ABORTED;
-					break;
-				}
-				parser.SkipRows();
-				continue;
-			}
+// Find the last end tag with the given name. Returns nullptr if there is none.
+static const char *FindLastEndTag(const char *beg, const char *end, const char *tag) {
+	for (auto ptr = end - 1; ptr > beg; ptr--) {
+		if (ptr[-1] != '<' || ptr[0] != '/') {
+			continue;
+		}
+		const auto name_beg = ptr + 1;
+		if (MatchXMLName(name_beg, SkipXMLName(name_beg, end), tag)) {
+			return ptr - 1;
+		}
+	}
+	return nullptr;
+}
 
-			// Resume normally
-			status = parser.Resume();
+// Parse the "r" attribute of the tag starting at ptr
+static bool TryParseRowNumber(const char *ptr, const char *end, idx_t &result) {
+	ptr = SkipXMLName(ptr + 1, end);
+	XMLRawAttribute attr;
+	while (ReadXMLAttribute(ptr, end, attr)) {
+		if (!attr.NameIs("r")) {
 			continue;
 		}
-		if (stream.IsDone()) {
-			break;
+		if (attr.value_beg == attr.value_end) {
+			return false;
 		}
-		if (status == XMLParseResult::ABORTED) {
-			break;
+		idx_t row = 0;
+		for (auto digit = attr.value_beg; digit < attr.value_end; digit++) {
+			if (*digit < '0' || *digit > '9') {
+				return false;
+			}
+			row = row * 10 + static_cast<idx_t>(*digit - '0');
 		}
+		result = row;
+		return true;
+	}
+	return false;
+}
 
-		// Otherwise, read more data
-		const auto read_size = stream.Read(buffer, XLSXGlobalState::BUFFER_SIZE);
-
-		// Update the progess
-		gstate.stream_pos += read_size;
+// Split the rows of a staged sheet into segments of roughly XLSX_SEGMENT_SIZE bytes
+static vector<XLSXSheetSegment> SplitSheet(const char *data, const idx_t size, const XLSXCellRange &range) {
+	vector<XLSXSheetSegment> result;
 
-		status = parser.Parse(buffer, read_size, stream.IsDone());
+	const auto end = data + size;
+	const auto data_tag = FindStartTag(data, end, "sheetData");
+	if (!data_tag) {
+		return result;
+	}
+	const auto data_tag_end = static_cast<const char *>(memchr(data_tag, '>', NumericCast<size_t>(end - data_tag)));
+	if (!data_tag_end || data_tag_end[-1] == '/') {
+		// No rows in the sheet
+		return result;
+	}
+	const auto rows_beg = data_tag_end + 1;
+	const auto rows_end = FindLastEndTag(rows_beg, end, "sheetData");
+	if (!rows_end) {
+		return result;
 	}
 
-	// Pad with empty rows if wanted (and needed)
-	if (options.has_explicit_range && !options.stop_at_empty) {
-		parser.FillRows();
+	// Find the row tags to split at. We can only split at rows with an explicit row number, as we
+	// would otherwise not know where the segment starts.
+	vector<std::pair<const char *, idx_t>> splits;
+	splits.emplace_back(rows_beg, 1);
+	while (static_cast<idx_t>(rows_end - splits.back().first) > 2 * XLSX_SEGMENT_SIZE) {
+		const auto row_tag = FindStartTag(splits.back().first + XLSX_SEGMENT_SIZE, rows_end, "row");
+		idx_t row_number;
+		if (!row_tag || !TryParseRowNumber(row_tag, rows_end, row_number) || row_number <= splits.back().second) {
+			break;
+		}
+		splits.emplace_back(row_tag, row_number);
 	}
 
-	// Cast all the strings to the correct types, unless they are already strings in which case we reference them
-	const auto row_count = chunk.size();
+	for (idx_t split_idx = 0; split_idx < splits.size(); split_idx++) {
+		const auto is_last = split_idx + 1 == splits.size();
+
+		XLSXSheetSegment segment;
+		segment.beg_pos = NumericCast<idx_t>(splits[split_idx].first - data);
+		segment.end_pos = NumericCast<idx_t>((is_last ? rows_end : splits[split_idx + 1].first) - data);
+		segment.first_row = splits[split_idx].second;
+		segment.beg_row = MaxValue(segment.first_row, range.beg.row);
+		segment.end_row = is_last ? range.end.row : MinValue(splits[split_idx + 1].second, range.end.row);
+		if (segment.beg_row >= segment.end_row) {
+			// No rows of interest in this segment
+			continue;
+		}
+		result.push_back(segment);
+	}
+	return result;
+}
+
+//-------------------------------------------------------------------
+// Sheet Index
+//-------------------------------------------------------------------
+// While a large sheet is inflated, the zip reader records a checkpoint
+// about every XLSX_CHECKPOINT_SPAN bytes, which is mapped to the first
+// row after it. Later scans of the sheet use these to start inflating
+// right before the first row of their range, and to split the sheet
+// into segments that are inflated in parallel, instead of inflating
+// the whole sheet into memory first.
+//-------------------------------------------------------------------
+static constexpr idx_t XLSX_CHECKPOINT_SPAN = XLSX_SEGMENT_SIZE;
+
+class XLSXSheetIndexBuilder {
+public:
+	// Map the checkpoints recorded so far to rows, given the next block of the sheet starting at block_pos
+	void Update(const vector<ZipInflateCheckpoint> &recorded, const char *block, idx_t size, idx_t block_pos);
+
+	shared_ptr<XLSXSheetIndex> index = make_shared_ptr<XLSXSheetIndex>();
+
+private:
+	// The next recorded checkpoint that has not been mapped yet
+	idx_t next_checkpoint = 0;
+};
+
+void XLSXSheetIndexBuilder::Update(const vector<ZipInflateCheckpoint> &recorded, const char *block, const idx_t size,
+                                   const idx_t block_pos) {
+	const auto block_end = block + size;
+	while (next_checkpoint < recorded.size()) {
+		const auto &checkpoint = recorded[next_checkpoint];
+		if (checkpoint.out_pos >= block_pos + size) {
+			// Not reached yet
+			break;
+		}
+		// Any row after the checkpoint will do, so we simply skip a row tag that is split between two blocks
+		const auto search_pos = MaxValue(checkpoint.out_pos, block_pos);
+		const auto row_tag = FindStartTag(block + (search_pos - block_pos), block_end, "row");
+		if (!row_tag) {
+			break;
+		}
+		const auto tag_end = static_cast<const char *>(memchr(row_tag, '>', NumericCast<size_t>(block_end - row_tag)));
+		if (!tag_end) {
+			break;
+		}
+		// We can only start at rows with an explicit row number, in order
+		idx_t row_number;
+		if (TryParseRowNumber(row_tag, tag_end, row_number) &&
+		    (index->checkpoints.empty() || row_number > index->checkpoints.back().row_number)) {
+			const auto row_pos = block_pos + NumericCast<idx_t>(row_tag - block);
+			index->checkpoints.push_back({checkpoint, row_pos, row_number});
+		}
+		next_checkpoint++;
+	}
+}
+
+// Split a sheet at the checkpoints of its index, so that every segment can be inflated on its own
+static vector<XLSXSheetSegment> SplitSheetAtCheckpoints(const XLSXSheetIndex &index, const idx_t sheet_size,
+                                                        const XLSXCellRange &range) {
+	vector<XLSXSheetSegment> result;
+	const auto &checkpoints = index.checkpoints;
+	for (idx_t split_idx = 0; split_idx <= checkpoints.size(); split_idx++) {
+		const auto is_first = split_idx == 0;
+		const auto is_last = split_idx == checkpoints.size();
+
+		// The first segment starts at the beginning of the sheet, the others at a checkpoint
+		XLSXSheetSegment segment;
+		segment.beg_pos = is_first ? 0 : checkpoints[split_idx - 1].row_pos;
+		segment.end_pos = is_last ? sheet_size : checkpoints[split_idx].row_pos;
+		segment.first_row = is_first ? 1 : checkpoints[split_idx - 1].row_number;
+		segment.beg_row = MaxValue(segment.first_row, range.beg.row);
+		segment.end_row = is_last ? range.end.row : MinValue(checkpoints[split_idx].row_number, range.end.row);
+		segment.checkpoint_idx = is_first ? DConstants::INVALID_INDEX : split_idx - 1;
+		if (segment.beg_row >= segment.end_row) {
+			// No rows of interest in this segment
+			continue;
+		}
+		result.push_back(segment);
+	}
+	return result;
+}
+
+// Whether a sheet is worth inflating into memory and splitting into segments
+static bool CanSplitSheet(ClientContext &context, const string &sheet_path, const idx_t sheet_size) {
+	if (IsXLSBPart(sheet_path)) {
+		// Binary sheets can't be split at row tags
+		return false;
+	}
+	if (sheet_size < 2 * XLSX_SEGMENT_SIZE) {
+		return false;
+	}
+	if (TaskScheduler::GetScheduler(context).NumberOfThreads() <= 1) {
+		return false;
+	}
+	// Make sure the staged sheet comfortably fits in memory
+	return sheet_size <= BufferManager::GetBufferManager(context).GetMaxMemory() / 4;
+}
+
+// The decoded rows of a sheet that are collected for the result cache. A sheet scanned in segments is only cached
+// once all of its segments have been read, with the rows of the segments combined in sheet order.
+class XLSXPendingResult {
+public:
+	XLSXPendingResult(string key_p, hash_t fingerprint_p) : key(std::move(key_p)), fingerprint(fingerprint_p) {
+	}
+
+	string key;
+	hash_t fingerprint;
+
+	mutex lock;
+	// The number of scans that still have to hand in their rows
+	idx_t remaining_scans = 1;
+	// The rows of each segment, in the order of the segments (none for segments after the first empty row)
+	vector<shared_ptr<ColumnDataCollection>> segment_rows;
+};
+
+// A segment of a sheet that is read until the first empty row. The segments are parsed in parallel, but the rows of
+// a segment are only returned once all segments before it are known to end without an empty row.
+class XLSXParsedSegment {
+public:
+	bool is_done = false;
+	// Whether the rows end at an empty row (or a gap in the row numbers) before the end of the segment
+	bool ends_early = false;
+	// The parsed rows, unless they were returned while parsing
+	shared_ptr<ColumnDataCollection> rows;
+};
+
+// A sheet that is being opened by a thread. Large sheets are inflated into memory,
+// so that their segments can be scanned in parallel.
+class XLSXStagedSheet {
+public:
+	explicit XLSXStagedSheet(idx_t sheet_idx_p) : sheet_idx(sheet_idx_p) {
+	}
+
+	idx_t sheet_idx;
+
+	// Held by the thread that is opening the sheet, other threads wait on it for the segments to become available
+	mutex lock;
+
+	// Everything below is only set once the sheet has been opened
+	bool is_open = false;
+	// The inflated sheet, unless the segments are inflated from checkpoints. Allocated through the buffer manager so
+	// that it counts towards the memory limit, and pinned until the last segment has been scanned.
+	BufferHandle data;
+	shared_ptr<const StringTable> strings;
+	vector<XLSXSheetSegment> segments;
+	// The next segment to hand out to a thread (protected by the global state lock)
+	idx_t next_segment = 0;
+	// If split at checkpoints, the index of the sheet and the fingerprint of the archive it belongs to
+	shared_ptr<const XLSXSheetIndex> index;
+	hash_t fingerprint = 0;
+	// Set if the rows of the segments are collected for the result cache
+	shared_ptr<XLSXPendingResult> pending;
+
+	// Set if the rows are read until the first empty row, in which case the rows of the segments are returned in
+	// order (protected by the global state lock)
+	bool is_ordered = false;
+	vector<XLSXParsedSegment> parsed;
+	// The segments before this one ended without an empty row
+	idx_t next_ordered = 0;
+	// Set once a segment ended at an empty row, the segments after it are dropped
+	atomic<bool> is_truncated {false};
+};
+
+// The shared string table of a workbook, loaded once and shared by all threads scanning its sheets
+class XLSXWorkbookStrings {
+public:
+	mutex lock;
+	bool is_loaded = false;
+	shared_ptr<const StringTable> strings;
+	// The number of sheets that still have to pick up the table
+	idx_t remaining_sheets = 0;
+};
+
+//-------------------------------------------------------------------
+// Profile
+//-------------------------------------------------------------------
+// Where the time of a scan goes, reported in the profile of the query
+// (EXPLAIN ANALYZE and the JSON profile), so that a sheet that is
+// bound by inflating can be told apart from one that is bound by
+// parsing or casting. Every thread collects its own profile, which is
+// merged into the global one whenever a scan is done. The timers are
+// only measured if profiling is enabled.
+//-------------------------------------------------------------------
+class XLSXScanProfile {
+public:
+	idx_t bytes_read = 0;
+	idx_t bytes_inflated = 0;
+	idx_t xml_events = 0;
+	idx_t cells_parsed = 0;
+	idx_t cells_padded = 0;
+	idx_t shared_string_bytes = 0;
+
+	// Opening sheets (including inflating them in a single pass or staging them), reading the sheet data (including
+	// streaming inflation) and parsing it, in seconds
+	double open_time = 0;
+	double read_time = 0;
+	double parse_time = 0;
+	// The time spent casting each output column from strings, in seconds
+	vector<double> cast_time;
+
+public:
+	void AddArchive(const ZipFileReader &archive) {
+		const auto stats = archive.GetStats();
+		bytes_read += stats.bytes_read;
+		bytes_inflated += stats.bytes_inflated;
+	}
+	void AddParser(const SheetParserStats &stats) {
+		xml_events += stats.xml_events;
+		cells_parsed += stats.cells_parsed;
+		cells_padded += stats.cells_padded;
+		shared_string_bytes += stats.shared_string_bytes;
+	}
+	// Add the other profile to this one, and reset it
+	void Merge(XLSXScanProfile &other);
+};
+
+void XLSXScanProfile::Merge(XLSXScanProfile &other) {
+	bytes_read += other.bytes_read;
+	bytes_inflated += other.bytes_inflated;
+	xml_events += other.xml_events;
+	cells_parsed += other.cells_parsed;
+	cells_padded += other.cells_padded;
+	shared_string_bytes += other.shared_string_bytes;
+	open_time += other.open_time;
+	read_time += other.read_time;
+	parse_time += other.parse_time;
+	cast_time.resize(MaxValue(cast_time.size(), other.cast_time.size()), 0);
+	for (idx_t out_idx = 0; out_idx < other.cast_time.size(); out_idx++) {
+		cast_time[out_idx] += other.cast_time[out_idx];
+	}
+
+	XLSXScanProfile reset;
+	reset.cast_time.resize(other.cast_time.size(), 0);
+	other = std::move(reset);
+}
+
+// Adds the time until it goes out of scope to a timer of the profile, if profiling is enabled
+class XLSXProfileTimer {
+public:
+	XLSXProfileTimer(bool enabled_p, double &total_p) : enabled(enabled_p), total(total_p) {
+		if (enabled) {
+			timer.Start();
+		}
+	}
+	~XLSXProfileTimer() {
+		if (enabled) {
+			timer.End();
+			total += timer.Elapsed();
+		}
+	}
+
+private:
+	bool enabled;
+	double &total;
+	Profiler timer;
+};
+
+//-------------------------------------------------------------------
+// Global State
+//-------------------------------------------------------------------
+class XLSXGlobalState final : public GlobalTableFunctionState {
+public:
+	XLSXGlobalState(const XLSXReadData &data, idx_t max_threads_p, vector<column_t> column_ids_p)
+	    : sheet_count(data.sheets.size()), max_threads(max_threads_p), column_ids(std::move(column_ids_p)),
+	      stream_pos(make_uniq_array<atomic<idx_t>>(sheet_count)),
+	      stream_len(make_uniq_array<atomic<idx_t>>(sheet_count)), projected(data.sheet_column_count, false) {
+		for (const auto column_id : column_ids) {
+			if (column_id < data.sheet_column_count) {
+				projected[column_id] = true;
+			}
+		}
+		for (idx_t file_idx = 0; file_idx < data.files.size(); file_idx++) {
+			workbooks.push_back(make_uniq<XLSXWorkbookStrings>());
+		}
+		for (auto &sheet : data.sheets) {
+			workbooks[sheet.file_idx]->remaining_sheets++;
+		}
+	}
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+
+	mutex lock;
+	// The next sheet to hand out to a thread
+	idx_t next_sheet = 0;
+	idx_t sheet_count;
+	idx_t max_threads;
+	// The sheets that are being opened, or that still have segments to hand out
+	vector<shared_ptr<XLSXStagedSheet>> staged_sheets;
+	// The shared strings of each file
+	vector<unique_ptr<XLSXWorkbookStrings>> workbooks;
+	// The archive of the first file, if it was opened during bind and not yet used by a scan
+	unique_ptr<ZipFileReader> open_archive;
+
+	// The columns to output
+	vector<column_t> column_ids;
+	// Whether to tokenize the sheet data directly, instead of parsing it with expat
+	bool fast_sheet_parser = true;
+
+	// The result cache, if enabled
+	shared_ptr<XLSXResultCache> result_cache;
+	// The outputs that are sheet columns (or sheet_row), and their types. Only these are cached, everything else
+	// is constant.
+	vector<idx_t> sheet_outputs;
+	vector<LogicalType> sheet_output_types;
+
+	// Progress counters for each sheet
+	unique_array<atomic<idx_t>> stream_pos;
+	unique_array<atomic<idx_t>> stream_len;
+
+	// Whether each sheet column is part of the output
+	vector<bool> projected;
+
+	// The merged profile of all threads, and whether the timers are measured
+	mutex profile_lock;
+	XLSXScanProfile profile;
+	bool is_profiled = false;
+
+public:
+	void MergeProfile(XLSXScanProfile &local_profile) {
+		lock_guard<mutex> guard(profile_lock);
+		profile.Merge(local_profile);
+	}
+
+	// The types of the collected rows. Without any sheet columns in the output, only the number of rows matters.
+	vector<LogicalType> GetDecodedTypes() const {
+		return sheet_output_types.empty() ? vector<LogicalType> {LogicalType::BOOLEAN} : sheet_output_types;
+	}
+
+	// Get the columns of the range of a sheet that have to be read, and their types
+	vector<XLSXReadColumn> GetReadColumns(const XLSXReadData &data, const XLSXSheetLayout &layout) const {
+		vector<XLSXReadColumn> result;
+		for (idx_t col_idx = 0; col_idx < layout.column_map.size(); col_idx++) {
+			const auto column_id = layout.column_map[col_idx];
+			if (projected[column_id]) {
+				result.push_back({col_idx, data.return_types[column_id], layout.source_types[col_idx]});
+			}
+		}
+		return result;
+	}
+};
+
+static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+	auto &data = input.bind_data->Cast<XLSXReadData>();
+
+	// Every sheet can be scanned by its own thread, and large sheets can be split further
+	idx_t max_threads = 0;
+	for (idx_t sheet_idx = 0; sheet_idx < data.sheets.size(); sheet_idx++) {
+		const auto sheet_size = data.GetLayout(sheet_idx).sheet_size;
+		const auto &sheet_path = data.sheets[sheet_idx].sheet_path;
+		max_threads += CanSplitSheet(context, sheet_path, sheet_size) ? sheet_size / XLSX_SEGMENT_SIZE : 1;
+	}
+	auto result = make_uniq<XLSXGlobalState>(data, max_threads, input.column_ids);
+
+	// Take over the first file from the bind, unless an earlier execution already did
+	if (data.open_workbook) {
+		auto &workbook = *data.open_workbook;
+		lock_guard<mutex> guard(workbook.lock);
+		result->open_archive = std::move(workbook.archive);
+		if (workbook.strings) {
+			auto &first_workbook = *result->workbooks[0];
+			first_workbook.strings = std::move(workbook.strings);
+			first_workbook.is_loaded = true;
+		}
+	}
+
+	Value fast_sheet_parser;
+	if (context.TryGetCurrentSetting("xlsx_fast_sheet_parser", fast_sheet_parser) && !fast_sheet_parser.IsNull()) {
+		result->fast_sheet_parser = BooleanValue::Get(fast_sheet_parser);
+	}
+	result->is_profiled = QueryProfiler::Get(context).IsEnabled();
+
+	for (idx_t out_idx = 0; out_idx < result->column_ids.size(); out_idx++) {
+		const auto column_id = result->column_ids[out_idx];
+		if (column_id < data.sheet_column_count) {
+			result->sheet_outputs.push_back(out_idx);
+			result->sheet_output_types.push_back(data.return_types[column_id]);
+		} else if (column_id == XLSX_COLUMN_IDENTIFIER_SHEET_ROW) {
+			result->sheet_outputs.push_back(out_idx);
+			result->sheet_output_types.push_back(LogicalType::BIGINT);
+		}
+	}
+	if (!result->sheet_outputs.empty()) {
+		// Otherwise there is nothing worth caching
+		result->result_cache = XLSXResultCache::Get(context);
+	}
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------
+// Local State
+//-------------------------------------------------------------------
+// The state of a single sheet (or sheet segment) being scanned by a thread
+class XLSXSheetScan {
+public:
+	XLSXSheetScan(ClientContext &context, idx_t sheet_idx_p, const XLSXCellRange &range,
+	              shared_ptr<const StringTable> strings_p, bool stop_at_empty, bool ignore_errors,
+	              const vector<XLSXReadColumn> &columns)
+	    : sheet_idx(sheet_idx_p), strings(std::move(strings_p)),
+	      parser(context, range, *strings, stop_at_empty, ignore_errors, columns) {
+	}
+
+	idx_t sheet_idx;
+
+	// Either the sheet is streamed from the archive...
+	unique_ptr<ZipFileReader> archive;
+	// (possibly resumed at a checkpoint and/or ending at rows_end, in which case the rows are wrapped in a
+	// sheetData element, and possibly mapping the checkpoints recorded by the archive to rows)
+	bool is_resumed = false;
+	idx_t rows_end = NumericLimits<idx_t>::Maximum();
+	idx_t wrap_pos = 0;
+	unique_ptr<XLSXSheetIndexBuilder> index_builder;
+	// ... or a segment of a staged sheet is read from memory
+	shared_ptr<XLSXStagedSheet> staged;
+	idx_t segment_idx = 0;
+	idx_t segment_pos = 0;
+
+	shared_ptr<const StringTable> strings;
+	SheetParser parser;
+
+	// Set if the decoded rows are collected for the result cache, or to be returned later
+	shared_ptr<XLSXPendingResult> pending;
+	shared_ptr<ColumnDataCollection> decoded;
+	ColumnDataAppendState append_state;
+	// Whether the rows are only collected, as the segments before this one may still end at an empty row
+	bool is_buffered = false;
+
+	XMLParseResult status = XMLParseResult::OK;
+	// Whether to pad with empty rows up to the end of the range
+	bool fill_rows = false;
+
+public:
+	bool IsDone() const;
+	// Get the next block of xml to parse, either read into the buffer or pointing into the staged sheet, the inflated
+	// sheet or the mapped file
+	idx_t Read(char *buffer, idx_t buffer_size, const char *&block);
+
+private:
+	static constexpr idx_t PREFIX_SIZE = sizeof(XLSX_SEGMENT_PREFIX) - 1;
+	static constexpr idx_t SUFFIX_SIZE = sizeof(XLSX_SEGMENT_SUFFIX) - 1;
+	idx_t GetWrapSize() const {
+		const auto is_bounded = rows_end != NumericLimits<idx_t>::Maximum();
+		return (is_resumed ? PREFIX_SIZE : 0) + (is_bounded ? SUFFIX_SIZE : 0);
+	}
+	idx_t ReadArchive(char *buffer, idx_t buffer_size, const char *&block);
+	idx_t GetSegmentSize() const {
+		const auto &segment = staged->segments[segment_idx];
+		return PREFIX_SIZE + (segment.end_pos - segment.beg_pos) + SUFFIX_SIZE;
+	}
+};
+
+bool XLSXSheetScan::IsDone() const {
+	if (archive) {
+		const auto rows_done = archive->IsDone() || archive->GetEntryPos() >= rows_end;
+		return rows_done && wrap_pos >= GetWrapSize();
+	}
+	return segment_pos >= GetSegmentSize();
+}
+
+idx_t XLSXSheetScan::ReadArchive(char *buffer, idx_t buffer_size, const char *&block) {
+	const auto prefix_size = is_resumed ? PREFIX_SIZE : 0;
+	if (wrap_pos < prefix_size) {
+		block = XLSX_SEGMENT_PREFIX + wrap_pos;
+		const auto block_size = prefix_size - wrap_pos;
+		wrap_pos += block_size;
+		return block_size;
+	}
+
+	const auto entry_pos = archive->GetEntryPos();
+	if (!archive->IsDone() && entry_pos < rows_end) {
+		const auto block_size = archive->ReadBlock(buffer, MinValue(buffer_size, rows_end - entry_pos), block);
+		if (index_builder) {
+			index_builder->Update(archive->GetCheckpoints(), block, block_size, entry_pos);
+		}
+		return block_size;
+	}
+
+	const auto offset = wrap_pos - prefix_size;
+	block = XLSX_SEGMENT_SUFFIX + offset;
+	const auto block_size = GetWrapSize() - wrap_pos;
+	wrap_pos += block_size;
+	return block_size;
+}
+
+idx_t XLSXSheetScan::Read(char *buffer, idx_t buffer_size, const char *&block) {
+	if (archive) {
+		return ReadArchive(buffer, buffer_size, block);
+	}
+
+	const auto &segment = staged->segments[segment_idx];
+	const auto body_size = segment.end_pos - segment.beg_pos;
+
+	idx_t block_size;
+	if (segment_pos < PREFIX_SIZE) {
+		block = XLSX_SEGMENT_PREFIX + segment_pos;
+		block_size = PREFIX_SIZE - segment_pos;
+	} else if (segment_pos < PREFIX_SIZE + body_size) {
+		const auto offset = segment_pos - PREFIX_SIZE;
+		block = const_char_ptr_cast(staged->data.Ptr()) + segment.beg_pos + offset;
+		block_size = MinValue(buffer_size, body_size - offset);
+	} else {
+		const auto offset = segment_pos - PREFIX_SIZE - body_size;
+		block = XLSX_SEGMENT_SUFFIX + offset;
+		block_size = SUFFIX_SIZE - offset;
+	}
+	segment_pos += block_size;
+	return block_size;
+}
+
+// A sheet replayed from the result cache, or the collected rows of a segment
+class XLSXCachedScan {
+public:
+	XLSXCachedScan(idx_t sheet_idx_p, shared_ptr<const ColumnDataCollection> rows_p)
+	    : sheet_idx(sheet_idx_p), rows(std::move(rows_p)) {
+		rows->InitializeScan(scan_state);
+		rows->InitializeScanChunk(chunk);
+	}
+
+	idx_t sheet_idx;
+	shared_ptr<const ColumnDataCollection> rows;
+	ColumnDataScanState scan_state;
+	DataChunk chunk;
+
+	// Set if returning the collected rows of a segment
+	shared_ptr<XLSXStagedSheet> staged;
+	idx_t segment_idx = 0;
+};
+
+class XLSXLocalState final : public LocalTableFunctionState {
+public:
+	XLSXLocalState() : buffer(make_unsafe_uniq_array_uninitialized<char>(BUFFER_SIZE)) {
+	}
+
+	// The sheet currently being scanned, if any. Either parsed, or replayed from the result cache.
+	unique_ptr<XLSXSheetScan> scan;
+	unique_ptr<XLSXCachedScan> cached;
+	// The collected rows of segments this thread returns next, in order
+	vector<unique_ptr<XLSXCachedScan>> next_segments;
+	unsafe_unique_array<char> buffer;
+	// The sheet columns of the output, as collected for the result cache or to be returned later
+	DataChunk decoded_chunk;
+	// Maps the result columns to the columns of the chunk of the sheet being scanned
+	vector<idx_t> sheet_columns;
+	// The batch of the sheet (or segment) being scanned. Never decreases, as required by order preserving sinks.
+	idx_t batch_index = 0;
+
+	string cast_err;
+	// What this thread did since its profile was last merged into the global one
+	XLSXScanProfile profile;
+
+	// 8kb buffer
+	static constexpr auto BUFFER_SIZE = 8096;
+};
+
+static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                     GlobalTableFunctionState *global_state) {
+	auto &gstate = global_state->Cast<XLSXGlobalState>();
+	auto result = make_uniq<XLSXLocalState>();
+	result->profile.cast_time.resize(gstate.column_ids.size(), 0);
+	result->decoded_chunk.InitializeEmpty(gstate.GetDecodedTypes());
+	return std::move(result);
+}
+
+// Inflate the whole sheet into memory
+static void StageSheet(ClientContext &context, ZipFileReader &archive, XLSXStagedSheet &staged) {
+	const auto sheet_size = archive.GetEntryLen();
+	staged.data = BufferManager::GetBufferManager(context).Allocate(MemoryTag::EXTENSION, sheet_size);
+
+	const auto ptr = char_ptr_cast(staged.data.Ptr());
+	idx_t total_size = 0;
+	while (!archive.IsDone() && total_size < sheet_size) {
+		const auto read_size = archive.Read(ptr + total_size, MinValue(sheet_size - total_size, XLSX_SEGMENT_SIZE));
+		if (read_size == 0) {
+			break;
+		}
+		total_size += read_size;
+	}
+	if (total_size != sheet_size) {
+		throw IOException("Failed to read sheet from xlsx file");
+	}
+}
+
+// Get the shared string table of the workbook, loading it if this is the first sheet of the workbook to be opened
+static shared_ptr<const StringTable> GetSharedStrings(ClientContext &context, const XLSXReadData &data,
+                                                      XLSXGlobalState &gstate, const idx_t file_idx,
+                                                      ZipFileReader &archive) {
+	auto &workbook = *gstate.workbooks[file_idx];
+	lock_guard<mutex> guard(workbook.lock);
+	if (!workbook.is_loaded) {
+		// The table is usually already cached by an earlier scan of the workbook
+		workbook.strings = XLSXSharedStringsCacheEntry::Load(context, data.files[file_idx], archive);
+		if (!workbook.strings) {
+			// There is no string table
+			workbook.strings = make_shared_ptr<StringTable>(BufferAllocator::Get(context));
+		}
+		workbook.is_loaded = true;
+	}
+	auto result = workbook.strings;
+	if (--workbook.remaining_sheets == 0) {
+		// All sheets have their reference, release ours
+		workbook.strings.reset();
+	}
+	return result;
+}
+
+// Release the shared string table of the workbook for a sheet that doesn't need it
+static void SkipSharedStrings(XLSXGlobalState &gstate, const idx_t file_idx) {
+	auto &workbook = *gstate.workbooks[file_idx];
+	lock_guard<mutex> guard(workbook.lock);
+	if (--workbook.remaining_sheets == 0) {
+		workbook.strings.reset();
+	}
+}
+
+// The key of the decoded rows of a sheet in the result cache, which depends on everything that affects the rows
+static string GetResultKey(const XLSXReadData &data, const XLSXGlobalState &gstate, const idx_t sheet_idx) {
+	const auto &sheet = data.sheets[sheet_idx];
+	const auto &layout = data.GetLayout(sheet_idx);
+	const auto &options = data.options;
+
+	auto key = data.files[sheet.file_idx] + "|" + GetSchemaKey(sheet.sheet_path, options);
+	key += "|" + std::to_string(layout.range.beg.row) + ":" + std::to_string(layout.range.beg.col);
+	key += "|" + std::to_string(layout.range.end.row) + ":" + std::to_string(layout.range.end.col);
+	key += options.stop_at_empty ? "|stop_at_empty" : "|";
+	key += options.ignore_errors ? "|ignore_errors" : "|";
+
+	// The columns that are read, where they are in the range and how they are decoded
+	for (const auto out_idx : gstate.sheet_outputs) {
+		const auto column_id = gstate.column_ids[out_idx];
+		if (column_id == XLSX_COLUMN_IDENTIFIER_SHEET_ROW) {
+			key += "|sheet_row";
+			continue;
+		}
+		key += "|" + data.return_types[column_id].ToString();
+		for (idx_t col_idx = 0; col_idx < layout.column_map.size(); col_idx++) {
+			if (layout.column_map[col_idx] == column_id) {
+				key += ":" + std::to_string(col_idx) + ":" +
+				       std::to_string(static_cast<int>(layout.source_types[col_idx]));
+				break;
+			}
+		}
+	}
+	return key;
+}
+
+// Start collecting the decoded rows of a scan, for the result cache and/or to return them later
+static void CollectRows(ClientContext &context, const XLSXGlobalState &gstate, XLSXSheetScan &scan,
+                        shared_ptr<XLSXPendingResult> pending, const bool is_buffered = false) {
+	if (!pending && !is_buffered) {
+		return;
+	}
+	scan.pending = std::move(pending);
+	scan.is_buffered = is_buffered;
+	scan.decoded = make_shared_ptr<ColumnDataCollection>(BufferManager::GetBufferManager(context),
+	                                                     gstate.GetDecodedTypes());
+	scan.decoded->InitializeAppend(scan.append_state);
+}
+
+// Hand in the decoded rows of a segment (nullptr if its rows are not returned), and cache the rows of the sheet once
+// all of its segments are in
+static void HandInRows(ClientContext &context, const XLSXReadData &data, const XLSXGlobalState &gstate,
+                       XLSXPendingResult &pending, const idx_t sheet_idx, const idx_t segment_idx,
+                       shared_ptr<ColumnDataCollection> rows) {
+	lock_guard<mutex> guard(pending.lock);
+	// The segments finish in any order, so keep their rows apart until all of them are in
+	if (pending.segment_rows.size() <= segment_idx) {
+		pending.segment_rows.resize(segment_idx + 1);
+	}
+	pending.segment_rows[segment_idx] = std::move(rows);
+	if (--pending.remaining_scans > 0) {
+		return;
+	}
+	shared_ptr<ColumnDataCollection> result;
+	for (auto &segment_rows : pending.segment_rows) {
+		if (!segment_rows) {
+			continue;
+		}
+		if (!result) {
+			result = std::move(segment_rows);
+		} else {
+			result->Combine(*segment_rows);
+		}
+	}
+	pending.segment_rows.clear();
+	if (!result) {
+		return;
+	}
+	const auto &sheet = data.sheets[sheet_idx];
+	gstate.result_cache->Store(context, pending.key, data.files[sheet.file_idx], sheet.sheet_name, pending.fingerprint,
+	                           std::move(result));
+}
+
+// Hand in the decoded rows of a finished scan for the result cache
+static void FinishRows(ClientContext &context, const XLSXReadData &data, const XLSXGlobalState &gstate,
+                       XLSXSheetScan &scan) {
+	if (!scan.pending) {
+		return;
+	}
+	HandInRows(context, data, gstate, *scan.pending, scan.sheet_idx, scan.segment_idx, std::move(scan.decoded));
+}
+
+// Open a sheet and either replay it from the result cache, prepare it to be scanned in segments, or start streaming
+// it directly. Returns false if the sheet was split into segments. The caller holds the lock of the staged sheet.
+static bool OpenSheet(ClientContext &context, const XLSXReadData &data, XLSXGlobalState &gstate,
+                      XLSXStagedSheet &staged, XLSXLocalState &lstate) {
+	const auto sheet_idx = staged.sheet_idx;
+	const auto &sheet = data.sheets[sheet_idx];
+	const auto &file_path = data.files[sheet.file_idx];
+	const auto &layout = data.GetLayout(sheet_idx);
+
+	// Reuse the archive opened during bind, if this is the first sheet of the first file to be opened
+	unique_ptr<ZipFileReader> archive;
+	if (sheet.file_idx == 0) {
+		lock_guard<mutex> guard(gstate.lock);
+		archive = std::move(gstate.open_archive);
+	}
+	if (!archive) {
+		archive = make_uniq<ZipFileReader>(context, file_path);
+	}
+
+	// Replay the sheet if its rows are cached
+	shared_ptr<XLSXPendingResult> pending;
+	if (gstate.result_cache) {
+		auto key = GetResultKey(data, gstate, sheet_idx);
+		const auto fingerprint = archive->GetFingerprint();
+		auto rows = gstate.result_cache->Lookup(key, fingerprint);
+		if (rows) {
+			// The shared strings are not needed
+			SkipSharedStrings(gstate, sheet.file_idx);
+			gstate.stream_len[sheet_idx] = rows->Count();
+			lstate.cached = make_uniq<XLSXCachedScan>(sheet_idx, std::move(rows));
+			lstate.profile.AddArchive(*archive);
+
+			lock_guard<mutex> guard(gstate.lock);
+			staged.is_open = true;
+			return true;
+		}
+		pending = make_shared_ptr<XLSXPendingResult>(std::move(key), fingerprint);
+	}
+
+	auto strings = GetSharedStrings(context, data, gstate, sheet.file_idx, *archive);
+
+	// Open the sheet to look at its size, it is reopened depending on how it is read
+	if (!archive->TryOpenEntry(sheet.sheet_path, 0)) {
+		throw InvalidInputException("Sheet '%s' not found in xlsx file \"%s\"", sheet.sheet_path, file_path);
+	}
+
+	// Set the progress counters
+	const auto sheet_size = archive->GetEntryLen();
+	gstate.stream_len[sheet_idx] = sheet_size;
+
+	// Large sheets are indexed the first time they are read in full. A streamed sheet is only indexed while the rows
+	// are not read until the first empty one, as we would otherwise not know whether a checkpoint comes before the
+	// end of the rows. Binary sheets are not indexed, as the checkpoints are placed by looking for row tags.
+	const auto fingerprint = archive->GetFingerprint();
+	const auto is_binary = IsXLSBPart(sheet.sheet_path);
+	const auto can_index = !is_binary && sheet_size >= 2 * XLSX_CHECKPOINT_SPAN;
+	shared_ptr<const XLSXSheetIndex> index;
+	if (can_index) {
+		index = XLSXSheetIndexCacheEntry::Lookup(context, file_path, sheet.sheet_path, fingerprint);
+	}
+
+	if (CanSplitSheet(context, sheet.sheet_path, sheet_size)) {
+		vector<XLSXSheetSegment> segments;
+		if (index) {
+			// Every segment is inflated on its own, starting at its checkpoint
+			segments = SplitSheetAtCheckpoints(*index, sheet_size, layout.range);
+		} else {
+			// Inflate the whole sheet, recording the checkpoints to split at next time
+			if (!archive->TryOpenEntry(sheet.sheet_path, XLSX_CHECKPOINT_SPAN)) {
+				throw IOException("Failed to read sheet from xlsx file");
+			}
+			StageSheet(context, *archive, staged);
+			XLSXSheetIndexBuilder builder;
+			builder.Update(archive->GetCheckpoints(), const_char_ptr_cast(staged.data.Ptr()), sheet_size, 0);
+			XLSXSheetIndexCacheEntry::Store(context, file_path, sheet.sheet_path, fingerprint,
+			                                std::move(builder.index));
+			segments = SplitSheet(const_char_ptr_cast(staged.data.Ptr()), sheet_size, layout.range);
+		}
+
+		if (pending) {
+			pending->remaining_scans = segments.size();
+		}
+		lstate.profile.AddArchive(*archive);
+
+		lock_guard<mutex> guard(gstate.lock);
+		staged.strings = std::move(strings);
+		staged.segments = std::move(segments);
+		staged.index = std::move(index);
+		staged.fingerprint = fingerprint;
+		staged.pending = std::move(pending);
+		if (data.options.stop_at_empty) {
+			staged.is_ordered = true;
+			staged.parsed.resize(staged.segments.size());
+		}
+		staged.is_open = true;
+		return false;
+	}
+
+	// Otherwise, stream the sheet
+	auto scan = make_uniq<XLSXSheetScan>(context, sheet_idx, layout.range, std::move(strings),
+	                                     data.options.stop_at_empty, data.options.ignore_errors,
+	                                     gstate.GetReadColumns(data, layout));
+	if (is_binary) {
+		scan->parser.SetBinary();
+	}
+	const auto checkpoint = index ? index->FindCheckpoint(layout.range.beg.row) : nullptr;
+	if (checkpoint) {
+		// Start inflating right before the first row of the range
+		if (!archive->TryResumeEntry(sheet.sheet_path, checkpoint->inflate) ||
+		    archive->Skip(checkpoint->row_pos - checkpoint->inflate.out_pos) !=
+		        checkpoint->row_pos - checkpoint->inflate.out_pos) {
+			throw IOException("Failed to read sheet from xlsx file");
+		}
+		scan->is_resumed = true;
+		scan->parser.SetFirstRow(checkpoint->row_number);
+		gstate.stream_pos[sheet_idx] = checkpoint->row_pos;
+	} else if (can_index && !index && !data.options.stop_at_empty) {
+		// Record the checkpoints while streaming the sheet
+		if (!archive->TryOpenEntry(sheet.sheet_path, XLSX_CHECKPOINT_SPAN)) {
+			throw IOException("Failed to read sheet from xlsx file");
+		}
+		scan->index_builder = make_uniq<XLSXSheetIndexBuilder>();
+	} else {
+		// Inflate the whole sheet in a single pass, if it fits in the inflate buffer
+		if (!archive->TryOpenEntry(sheet.sheet_path)) {
+			throw IOException("Failed to read sheet from xlsx file");
+		}
+	}
+	scan->archive = std::move(archive);
+	scan->fill_rows = data.options.has_explicit_range && !data.options.stop_at_empty;
+	CollectRows(context, gstate, *scan, std::move(pending));
+	lstate.scan = std::move(scan);
+
+	lock_guard<mutex> guard(gstate.lock);
+	staged.is_open = true;
+	return true;
+}
+
+// Open a segment of a staged sheet. Unless it is live, its rows are only collected, as the segments before it may
+// still end at an empty row.
+static unique_ptr<XLSXSheetScan> OpenSegment(ClientContext &context, const XLSXReadData &data,
+                                             const XLSXGlobalState &gstate, shared_ptr<XLSXStagedSheet> staged,
+                                             const idx_t segment_idx, const bool is_live) {
+	const auto &segment = staged->segments[segment_idx];
+	const auto &layout = data.GetLayout(staged->sheet_idx);
+
+	// Only read the rows of this segment
+	auto range = layout.range;
+	range.beg.row = segment.beg_row;
+	range.end.row = segment.end_row;
+
+	auto scan = make_uniq<XLSXSheetScan>(context, staged->sheet_idx, range, staged->strings, data.options.stop_at_empty,
+	                                     data.options.ignore_errors, gstate.GetReadColumns(data, layout));
+	if (staged->index) {
+		// Inflate the segment from its checkpoint, with an archive of our own
+		const auto &sheet = data.sheets[staged->sheet_idx];
+		auto archive = make_uniq<ZipFileReader>(context, data.files[sheet.file_idx]);
+		if (archive->GetFingerprint() != staged->fingerprint) {
+			throw IOException("xlsx file \"%s\" changed while it was being read", data.files[sheet.file_idx]);
+		}
+		idx_t entry_pos = 0;
+		bool is_open;
+		if (segment.checkpoint_idx != DConstants::INVALID_INDEX) {
+			const auto &checkpoint = staged->index->checkpoints[segment.checkpoint_idx];
+			is_open = archive->TryResumeEntry(sheet.sheet_path, checkpoint.inflate);
+			entry_pos = checkpoint.inflate.out_pos;
+			scan->is_resumed = true;
+		} else {
+			is_open = archive->TryOpenEntry(sheet.sheet_path, 0);
+		}
+		if (!is_open || archive->Skip(segment.beg_pos - entry_pos) != segment.beg_pos - entry_pos) {
+			throw IOException("Failed to read sheet from xlsx file");
+		}
+		if (segment.end_pos < archive->GetEntryLen()) {
+			scan->rows_end = segment.end_pos;
+		}
+		scan->archive = std::move(archive);
+	}
+	scan->parser.SetFirstRow(segment.first_row);
+	// Pad the rows between this segment and the next one, and at the end of an explicit range, unless these are the
+	// empty rows to stop at
+	const auto is_last = segment_idx + 1 == staged->segments.size();
+	scan->fill_rows = !data.options.stop_at_empty && (!is_last || data.options.has_explicit_range);
+	scan->segment_idx = segment_idx;
+	CollectRows(context, gstate, *scan, staged->pending, !is_live);
+	scan->staged = std::move(staged);
+	return scan;
+}
+
+// Find the next sheet or sheet segment to scan
+static bool TryOpenNextScan(ClientContext &context, const XLSXReadData &data, XLSXGlobalState &gstate,
+                            XLSXLocalState &lstate) {
+	while (true) {
+		shared_ptr<XLSXStagedSheet> segment_sheet;
+		idx_t segment_idx = 0;
+		bool segment_is_live = true;
+		shared_ptr<XLSXStagedSheet> opening_sheet;
+		shared_ptr<XLSXStagedSheet> new_sheet;
+		unique_lock<mutex> new_sheet_lock;
+		{
+			lock_guard<mutex> guard(gstate.lock);
+
+			// Prefer scanning segments of sheets that are already open. Segments that come before the batch this
+			// thread already scanned are left to the threads that are still behind it.
+			auto &staged_sheets = gstate.staged_sheets;
+			for (idx_t sheet_idx = 0; sheet_idx < staged_sheets.size();) {
+				auto &staged = staged_sheets[sheet_idx];
+				if (!staged->is_open) {
+					opening_sheet = staged;
+				} else if (staged->next_segment < staged->segments.size()) {
+					if (GetBatchIndex(staged->sheet_idx, staged->next_segment) < lstate.batch_index) {
+						sheet_idx++;
+						continue;
+					}
+					segment_sheet = staged;
+					segment_idx = staged->next_segment++;
+					segment_is_live = !staged->is_ordered || segment_idx == staged->next_ordered;
+					break;
+				} else {
+					// All segments have been handed out
+					staged_sheets.erase_at(sheet_idx);
+					continue;
+				}
+				sheet_idx++;
+			}
+
+			if (!segment_sheet) {
+				if (gstate.next_sheet < gstate.sheet_count) {
+					// Open the next sheet. Lock it before it becomes visible to the other threads.
+					new_sheet = make_shared_ptr<XLSXStagedSheet>(gstate.next_sheet++);
+					new_sheet_lock = unique_lock<mutex>(new_sheet->lock);
+					staged_sheets.push_back(new_sheet);
+				} else if (!opening_sheet) {
+					// Nothing left to scan
+					return false;
+				}
+			}
+		}
 
-	for (idx_t col_idx = 0; col_idx < output.ColumnCount(); col_idx++) {
-		auto &source_col = chunk.data[col_idx];
-		auto &target_col = output.data[col_idx];
-		auto &xlsx_type = bind_data.source_types[col_idx];
+		if (segment_sheet) {
+			lstate.batch_index = GetBatchIndex(segment_sheet->sheet_idx, segment_idx);
+			lstate.scan = OpenSegment(context, data, gstate, std::move(segment_sheet), segment_idx, segment_is_live);
+			return true;
+		}
+
+		if (new_sheet) {
+			lstate.batch_index = GetBatchIndex(new_sheet->sheet_idx, 0);
+			if (OpenSheet(context, data, gstate, *new_sheet, lstate)) {
+				return true;
+			}
+			// The sheet was split into segments, pick one up
+			continue;
+		}
+
+		// Another thread is still opening a sheet that may be split into segments, wait for it
+		lock_guard<mutex> wait(opening_sheet->lock);
+		if (!opening_sheet->is_open) {
+			// Opening the sheet failed, the error is reported by the thread that opened it
+			return false;
+		}
+	}
+}
+
+// Finish a segment of a sheet that is read until the first empty row. Once all segments before it are known to end
+// without an empty row, its collected rows are returned by this thread, along with the rows of the segments after it
+// that are already parsed. Segments after the first one that ends at an empty row are dropped.
+static void FinishOrderedSegment(ClientContext &context, const XLSXReadData &data, XLSXGlobalState &gstate,
+                                 XLSXLocalState &lstate) {
+	auto &scan = *lstate.scan;
+	auto &staged = *scan.staged;
+	const auto &parser = scan.parser;
+	const auto &segment = staged.segments[scan.segment_idx];
+	const auto is_last = scan.segment_idx + 1 == staged.segments.size();
+
+	// The rows also end early if they don't reach the next segment, the rows in between are empty
+	const auto ends_early =
+	    parser.FoundEmptyRow() || parser.FoundSkippedRow() || (!is_last && parser.GetLastRow() + 1 < segment.end_row);
+	if (!scan.is_buffered) {
+		// The rows were returned while parsing
+		FinishRows(context, data, gstate, scan);
+	}
+
+	vector<idx_t> dropped;
+	{
+		lock_guard<mutex> guard(gstate.lock);
+		if (staged.is_truncated) {
+			dropped.push_back(scan.segment_idx);
+		} else {
+			auto &parsed = staged.parsed[scan.segment_idx];
+			parsed.is_done = true;
+			parsed.ends_early = ends_early;
+			if (scan.is_buffered) {
+				parsed.rows = std::move(scan.decoded);
+			}
+		}
+		// Return the segments whose turn it is now
+		while (!staged.is_truncated && staged.next_ordered < staged.parsed.size() &&
+		       staged.parsed[staged.next_ordered].is_done) {
+			const auto segment_idx = staged.next_ordered++;
+			auto &parsed = staged.parsed[segment_idx];
+			if (parsed.rows) {
+				auto replay = make_uniq<XLSXCachedScan>(staged.sheet_idx, parsed.rows);
+				replay->staged = scan.staged;
+				replay->segment_idx = segment_idx;
+				lstate.next_segments.push_back(std::move(replay));
+			}
+			if (!parsed.ends_early) {
+				continue;
+			}
+			// Drop the segments after the empty row that are already parsed, and don't hand out the others. The
+			// ones still being parsed are dropped once they are done.
+			staged.is_truncated = true;
+			for (idx_t later_idx = segment_idx + 1; later_idx < staged.parsed.size(); later_idx++) {
+				auto &later = staged.parsed[later_idx];
+				if (later.is_done || later_idx >= staged.next_segment) {
+					later.rows.reset();
+					dropped.push_back(later_idx);
+				}
+			}
+			staged.next_segment = staged.segments.size();
+		}
+	}
+	if (staged.pending) {
+		for (const auto segment_idx : dropped) {
+			HandInRows(context, data, gstate, *staged.pending, staged.sheet_idx, segment_idx, nullptr);
+		}
+	}
+}
+
+// Start returning the collected rows of the next segment, if there are any left
+static bool TryReturnNextSegment(XLSXLocalState &lstate) {
+	if (lstate.next_segments.empty()) {
+		return false;
+	}
+	lstate.cached = std::move(lstate.next_segments.front());
+	lstate.next_segments.erase_at(0);
+	lstate.batch_index = GetBatchIndex(lstate.cached->sheet_idx, lstate.cached->segment_idx);
+	return true;
+}
+
+// Hand in the returned rows of a segment for the result cache
+static void FinishReturnedSegment(ClientContext &context, const XLSXReadData &data, const XLSXGlobalState &gstate,
+                                  XLSXCachedScan &cached) {
+	auto &staged = *cached.staged;
+	auto rows = std::move(staged.parsed[cached.segment_idx].rows);
+	if (staged.pending) {
+		HandInRows(context, data, gstate, *staged.pending, cached.sheet_idx, cached.segment_idx, std::move(rows));
+	}
+}
+
+//-------------------------------------------------------------------
+// Execute
+//-------------------------------------------------------------------
+
+static void TryCastFromString(XLSXLocalState &state, bool ignore_errors, const idx_t col_idx, ClientContext &context,
+                              Vector &target_col) {
+
+	auto &chunk = state.scan->parser.GetChunk();
+	auto &source_col = chunk.data[col_idx];
+	const auto row_count = chunk.size();
+
+	const auto ok = VectorOperations::TryCast(context, source_col, target_col, row_count, &state.cast_err);
+	if (!ok && !ignore_errors) {
+		// Figure out which cell failed
+		const auto &source_validity = FlatVector::Validity(source_col);
+		const auto &target_validity = FlatVector::Validity(target_col);
+		for (idx_t row_idx = 0; row_idx < row_count; row_idx++) {
+			if (source_validity.RowIsValid(row_idx) != target_validity.RowIsValid(row_idx)) {
+				// If the string is empty, allow it to be cast to NULL
+				if (!FlatVector::GetData<string_t>(source_col)[row_idx].Empty()) {
+					const auto cell_name = state.scan->parser.GetCellName(row_idx, col_idx);
+					throw InvalidInputException("read_xlsx: Failed to parse cell '%s': %s", cell_name, state.cast_err);
+				}
+			}
+		}
+	}
+}
+
+// Parse the next chunk of the current file into the parser chunk. Returns the number of rows parsed.
+static idx_t ParseNextChunk(const XLSXReadOptions &options, XLSXGlobalState &gstate, XLSXLocalState &lstate) {
+	auto &scan = *lstate.scan;
+	const auto buffer = lstate.buffer.get();
+
+	auto &parser = scan.parser;
+	auto &status = scan.status;
+	// Binary sheets are always tokenized, there is no XML to hand to expat
+	const auto fast = gstate.fast_sheet_parser || parser.IsBinary();
+	auto &profile = lstate.profile;
+
+	// Ready the chunk
+	auto &chunk = parser.GetChunk();
+	chunk.Reset();
+
+	while (chunk.size() != STANDARD_VECTOR_SIZE) {
+		if (status == XMLParseResult::SUSPENDED) {
+			if (parser.FoundSkippedRow()) {
+				if (options.stop_at_empty) {
+					status = XMLParseResult::ABORTED;
+					break;
+				}
+				parser.SkipRows();
+				continue;
+			}
+
+			// Resume normally
+			XLSXProfileTimer timer(gstate.is_profiled, profile.parse_time);
+			status = fast ? parser.ResumeRows() : parser.Resume();
+			continue;
+		}
+		if (scan.IsDone()) {
+			break;
+		}
+		if (status == XMLParseResult::ABORTED) {
+			break;
+		}
+
+		// Otherwise, read more data
+		const char *block;
+		idx_t read_size;
+		{
+			XLSXProfileTimer timer(gstate.is_profiled, profile.read_time);
+			read_size = scan.Read(buffer, XLSXLocalState::BUFFER_SIZE, block);
+		}
+
+		// Update the progess
+		gstate.stream_pos[scan.sheet_idx] += read_size;
+
+		const auto final = scan.IsDone();
+		XLSXProfileTimer timer(gstate.is_profiled, profile.parse_time);
+		status = fast ? parser.ParseRows(block, read_size, final) : parser.Parse(block, read_size, final);
+	}
+
+	// Pad with empty rows if wanted (and needed)
+	if (scan.fill_rows) {
+		parser.FillRows();
+	}
+
+	return chunk.size();
+}
+
+// Read the next chunk of a sheet replayed from the result cache, or of the collected rows of a segment. Returns the
+// number of rows read.
+static idx_t ReplayNextChunk(XLSXGlobalState &gstate, XLSXCachedScan &cached) {
+	if (!cached.rows->Scan(cached.scan_state, cached.chunk)) {
+		return 0;
+	}
+	if (!cached.staged) {
+		// The progress of a segment is counted while parsing it
+		gstate.stream_pos[cached.sheet_idx] += cached.chunk.size();
+	}
+	return cached.chunk.size();
+}
+
+// Get the next chunk of rows of the current sheet (or segment) in the chunk of the parser or the replayed rows, moving
+// on to the next sheet when it is done. Returns the number of rows, zero if there are no more sheets.
+static idx_t ScanNextChunk(ClientContext &context, const XLSXReadData &bind_data, XLSXGlobalState &gstate,
+                           XLSXLocalState &lstate) {
+	idx_t row_count = 0;
+	while (row_count == 0) {
+		if (!lstate.scan && !lstate.cached && !TryReturnNextSegment(lstate)) {
+			bool is_open;
+			{
+				XLSXProfileTimer timer(gstate.is_profiled, lstate.profile.open_time);
+				is_open = TryOpenNextScan(context, bind_data, gstate, lstate);
+			}
+			if (!is_open) {
+				// No more sheets to scan
+				gstate.MergeProfile(lstate.profile);
+				return 0;
+			}
+		}
+		if (lstate.cached) {
+			row_count = ReplayNextChunk(gstate, *lstate.cached);
+			if (row_count == 0) {
+				if (lstate.cached->staged) {
+					FinishReturnedSegment(context, bind_data, gstate, *lstate.cached);
+				}
+				lstate.cached.reset();
+			}
+			continue;
+		}
+		auto &scan = *lstate.scan;
+		// Stop parsing a segment once an earlier one ended at an empty row, its rows are dropped anyway
+		const auto is_dropped = scan.is_buffered && scan.staged->is_truncated;
+		row_count = is_dropped ? 0 : ParseNextChunk(bind_data.options, gstate, lstate);
+		if (row_count == 0) {
+			// This sheet (or segment) is done, move on to the next one
+			if (scan.archive && !scan.staged) {
+				gstate.stream_pos[scan.sheet_idx] = gstate.stream_len[scan.sheet_idx].load();
+			}
+			if (scan.index_builder) {
+				const auto &sheet = bind_data.sheets[scan.sheet_idx];
+				XLSXSheetIndexCacheEntry::Store(context, bind_data.files[sheet.file_idx], sheet.sheet_path,
+				                                scan.archive->GetFingerprint(), std::move(scan.index_builder->index));
+			}
+			if (scan.staged && scan.staged->is_ordered) {
+				FinishOrderedSegment(context, bind_data, gstate, lstate);
+			} else {
+				FinishRows(context, bind_data, gstate, scan);
+			}
+			if (scan.archive) {
+				lstate.profile.AddArchive(*scan.archive);
+			}
+			lstate.profile.AddParser(scan.parser.GetStats());
+			gstate.MergeProfile(lstate.profile);
+			lstate.scan.reset();
+		}
+	}
+	return row_count;
+}
+
+// Fill the output with the rows just scanned
+static void FillOutput(ClientContext &context, const XLSXReadData &bind_data, XLSXGlobalState &gstate,
+                       XLSXLocalState &lstate, const idx_t row_count, DataChunk &output) {
+	auto &options = bind_data.options;
+	const auto sheet_idx = lstate.cached ? lstate.cached->sheet_idx : lstate.scan->sheet_idx;
+	const auto &sheet = bind_data.sheets[sheet_idx];
+	const auto &layout = bind_data.GetLayout(sheet_idx);
+
+	// Map the result columns to the columns of the chunk, which only holds the columns of the range that are read.
+	// Columns not present in the sheet are NULL.
+	auto &sheet_columns = lstate.sheet_columns;
+	if (!lstate.cached) {
+		const auto &range_columns = lstate.scan->parser.GetColumns();
+		sheet_columns.assign(bind_data.sheet_column_count, DConstants::INVALID_INDEX);
+		for (idx_t col_idx = 0; col_idx < range_columns.size(); col_idx++) {
+			sheet_columns[layout.column_map[range_columns[col_idx]]] = col_idx;
+		}
+	}
+
+	// The index of the next sheet column in the cached rows
+	idx_t cached_idx = 0;
+	for (idx_t out_idx = 0; out_idx < gstate.column_ids.size(); out_idx++) {
+		const auto column_id = gstate.column_ids[out_idx];
+		auto &target_col = output.data[out_idx];
+
+		if (column_id == XLSX_COLUMN_IDENTIFIER_SHEET_NAME) {
+			target_col.Reference(Value(sheet.sheet_name));
+			continue;
+		}
+		if (column_id == XLSX_COLUMN_IDENTIFIER_FILENAME) {
+			target_col.Reference(Value(bind_data.files[sheet.file_idx]));
+			continue;
+		}
+		const auto is_sheet_row = column_id == XLSX_COLUMN_IDENTIFIER_SHEET_ROW;
+		if (IsVirtualColumn(column_id) && !is_sheet_row) {
+			// Only the row count matters
+			target_col.Reference(Value(target_col.GetType()));
+			continue;
+		}
+		if (column_id >= bind_data.sheet_column_count && !is_sheet_row) {
+			// The per-file constant columns (filename, hive partitions)
+			target_col.Reference(bind_data.file_constants[sheet.file_idx][column_id - bind_data.sheet_column_count]);
+			continue;
+		}
+
+		if (lstate.cached) {
+			// The rows were already decoded and cast
+			target_col.Reference(lstate.cached->chunk.data[cached_idx++]);
+			continue;
+		}
+
+		if (is_sheet_row) {
+			const auto &parser = lstate.scan->parser;
+			const auto sheet_rows = FlatVector::GetData<int64_t>(target_col);
+			for (idx_t row_idx = 0; row_idx < row_count; row_idx++) {
+				sheet_rows[row_idx] = NumericCast<int64_t>(parser.GetSheetRow(row_idx));
+			}
+			continue;
+		}
+
+		const auto col_idx = sheet_columns[column_id];
+		if (col_idx == DConstants::INVALID_INDEX) {
+			target_col.Reference(Value(target_col.GetType()));
+			continue;
+		}
+
+		// The parser already decoded numbers, booleans and serial dates into the target type, reference those.
+		// Everything else is read as strings, and cast to the correct type here.
+		auto &source_col = lstate.scan->parser.GetChunk().data[col_idx];
 
 		const auto source_type = source_col.GetType().id();
 		const auto target_type = target_col.GetType().id();
@@ -694,26 +2583,57 @@ static void Execute(ClientContext &context, TableFunctionInput &data, DataChunk
 			continue;
 		}
 
-		// Clear the cast vector
-		gstate.cast_vec.Reset();
-
-		if (xlsx_type == XLSXCellType::NUMBER && target_type == LogicalTypeId::TIME) {
-			TryCastTime(gstate, options.ignore_errors, col_idx, context, target_col);
-		} else if (xlsx_type == XLSXCellType::NUMBER && target_type == LogicalTypeId::DATE) {
-			TryCastDate(gstate, options.ignore_errors, col_idx, context, target_col);
-		} else if (xlsx_type == XLSXCellType::NUMBER && target_type == LogicalTypeId::TIMESTAMP) {
-			TryCastTimestamp(gstate, options.ignore_errors, col_idx, context, target_col);
-		} else {
-			// Cast the from string to the target type
-			TryCastFromString(gstate, options.ignore_errors, col_idx, context, target_col);
-		}
+		// Cast the from string to the target type
+		XLSXProfileTimer timer(gstate.is_profiled, lstate.profile.cast_time[out_idx]);
+		TryCastFromString(lstate, options.ignore_errors, col_idx, context, target_col);
 	}
+
 	output.SetCapacity(row_count);
 	output.SetCardinality(row_count);
 
+	if (lstate.scan && lstate.scan->decoded) {
+		// Collect the sheet columns for the result cache, or to return them later
+		auto &decoded_chunk = lstate.decoded_chunk;
+		for (idx_t col_idx = 0; col_idx < gstate.sheet_outputs.size(); col_idx++) {
+			decoded_chunk.data[col_idx].Reference(output.data[gstate.sheet_outputs[col_idx]]);
+		}
+		if (gstate.sheet_outputs.empty()) {
+			decoded_chunk.data[0].Reference(Value(LogicalType::BOOLEAN));
+		}
+		decoded_chunk.SetCardinality(row_count);
+		lstate.scan->decoded->Append(lstate.scan->append_state, decoded_chunk);
+	}
+}
+
+static void Execute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<XLSXReadData>();
+	auto &gstate = data.global_state->Cast<XLSXGlobalState>();
+	auto &lstate = data.local_state->Cast<XLSXLocalState>();
+
+	while (true) {
+		const auto row_count = ScanNextChunk(context, bind_data, gstate, lstate);
+		if (row_count == 0) {
+			return;
+		}
+		FillOutput(context, bind_data, gstate, lstate, row_count, output);
+		if (!lstate.scan || !lstate.scan->is_buffered) {
+			break;
+		}
+		// The rows were only collected, keep parsing
+		output.Reset();
+	}
 	output.Verify();
 }
 
+// The batch of the rows that were just returned, so that order preserving sinks can scan in parallel
+static OperatorPartitionData GetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input) {
+	if (input.partition_info.RequiresPartitionColumns()) {
+		throw InternalException("read_xlsx: partition columns are not supported");
+	}
+	auto &lstate = input.local_state->Cast<XLSXLocalState>();
+	return OperatorPartitionData(lstate.batch_index);
+}
+
 //-------------------------------------------------------------------
 // Progress
 //-------------------------------------------------------------------
@@ -724,10 +2644,68 @@ static double Progress(ClientContext &context, const FunctionData *bind_data_p,
 	}
 
 	const auto &state = global_state->Cast<XLSXGlobalState>();
-	const auto pos = static_cast<double>(state.stream_pos.load());
-	const auto len = static_cast<double>(state.stream_len);
+	if (state.sheet_count == 0) {
+		return 0;
+	}
+
+	// Every sheet contributes equally to the progress
+	double progress = 0;
+	for (idx_t sheet_idx = 0; sheet_idx < state.sheet_count; sheet_idx++) {
+		const auto pos = static_cast<double>(state.stream_pos[sheet_idx].load());
+		const auto len = static_cast<double>(state.stream_len[sheet_idx].load());
+		if (pos != 0 && len != 0) {
+			progress += MinValue(pos / len, 1.0);
+		}
+	}
+	return (progress / static_cast<double>(state.sheet_count)) * 100.0;
+}
 
-	return (pos == 0 || len == 0) ? 0 : (pos / len) * 100.0;
+//-------------------------------------------------------------------
+// Profile Output
+//-------------------------------------------------------------------
+static InsertionOrderPreservingMap<string> DynamicToString(TableFunctionDynamicToStringInput &input) {
+	InsertionOrderPreservingMap<string> result;
+	if (!input.global_state || !input.bind_data) {
+		return result;
+	}
+	auto &bind_data = input.bind_data->Cast<XLSXReadData>();
+	auto &gstate = input.global_state->Cast<XLSXGlobalState>();
+
+	XLSXScanProfile profile;
+	{
+		lock_guard<mutex> guard(gstate.profile_lock);
+		profile = gstate.profile;
+	}
+	if (input.local_state) {
+		// Whatever this thread did since it last merged its profile
+		auto local_profile = input.local_state->Cast<XLSXLocalState>().profile;
+		profile.Merge(local_profile);
+	}
+
+	// The files left to scan after pruning
+	result["Total Files Read"] = std::to_string(bind_data.files.size());
+	result["Bytes Read"] = std::to_string(profile.bytes_read);
+	result["Bytes Inflated"] = std::to_string(profile.bytes_inflated);
+	result["XML Events"] = std::to_string(profile.xml_events);
+	result["Cells Parsed"] = std::to_string(profile.cells_parsed);
+	result["Cells Padded"] = std::to_string(profile.cells_padded);
+	result["Shared String Bytes"] = std::to_string(profile.shared_string_bytes);
+	if (!gstate.is_profiled) {
+		return result;
+	}
+	result["Open Time"] = StringUtil::Format("%.3fs", profile.open_time);
+	result["Read Time"] = StringUtil::Format("%.3fs", profile.read_time);
+	result["Parse Time"] = StringUtil::Format("%.3fs", profile.parse_time);
+	for (idx_t out_idx = 0; out_idx < profile.cast_time.size(); out_idx++) {
+		const auto column_id = gstate.column_ids[out_idx];
+		if (profile.cast_time[out_idx] == 0 || column_id >= bind_data.column_names.size()) {
+			// Not cast, the parser decoded the column (or it is not a sheet column)
+			continue;
+		}
+		result["Cast Time (" + bind_data.column_names[column_id] + ")"] =
+		    StringUtil::Format("%.3fs", profile.cast_time[out_idx]);
+	}
+	return result;
 }
 
 static unique_ptr<TableRef> XLSXReplacementScan(ClientContext &context, ReplacementScanInput &input,
@@ -735,7 +2713,7 @@ static unique_ptr<TableRef> XLSXReplacementScan(ClientContext &context, Replacem
 	const auto table_name = ReplacementScan::GetFullPath(input);
 	const auto lower_name = StringUtil::Lower(table_name);
 
-	if (!StringUtil::EndsWith(lower_name, ".xlsx")) {
+	if (!StringUtil::EndsWith(lower_name, ".xlsx") && !StringUtil::EndsWith(lower_name, ".xlsb")) {
 		return nullptr;
 	}
 
@@ -754,24 +2732,57 @@ TableFunction ReadXLSX::GetFunction() {
 
 	TableFunction read_xlsx("read_xlsx", {LogicalType::VARCHAR}, Execute, Bind);
 	read_xlsx.init_global = InitGlobal;
+	read_xlsx.init_local = InitLocal;
 	read_xlsx.table_scan_progress = Progress;
+	read_xlsx.get_partition_data = GetPartitionData;
+	read_xlsx.cardinality = Cardinality;
+	read_xlsx.dynamic_to_string = DynamicToString;
+	read_xlsx.get_virtual_columns = GetVirtualColumns;
+	read_xlsx.pushdown_complex_filter = PushdownComplexFilter;
+	read_xlsx.projection_pushdown = true;
 
 	// Parameters
 	read_xlsx.named_parameters["header"] = LogicalType::BOOLEAN;
 	read_xlsx.named_parameters["all_varchar"] = LogicalType::BOOLEAN;
 	read_xlsx.named_parameters["ignore_errors"] = LogicalType::BOOLEAN;
 	read_xlsx.named_parameters["range"] = LogicalType::VARCHAR;
-	read_xlsx.named_parameters["sheet"] = LogicalType::VARCHAR;
+	read_xlsx.named_parameters["sheet"] = LogicalType::ANY;
 	read_xlsx.named_parameters["stop_at_empty"] = LogicalType::BOOLEAN;
+	read_xlsx.named_parameters["sample_size"] = LogicalType::BIGINT;
 	read_xlsx.named_parameters["empty_as_varchar"] = LogicalType::BOOLEAN;
 	read_xlsx.named_parameters["normalize_names"] = LogicalType::BOOLEAN;
 
+	// union_by_name, filename, hive_partitioning, hive_types and hive_types_autocast
+	MultiFileReader::AddParameters(read_xlsx);
+
 	return read_xlsx;
 }
 
 void ReadXLSX::Register(ExtensionLoader &loader) {
-	loader.RegisterFunction(GetFunction());
-	loader.GetDatabaseInstance().config.replacement_scans.emplace_back(XLSXReplacementScan);
+	// Accept either a single path (or glob) or a list of them
+	TableFunctionSet read_xlsx_set("read_xlsx");
+	auto read_xlsx = GetFunction();
+	read_xlsx_set.AddFunction(read_xlsx);
+	read_xlsx.arguments = {LogicalType::LIST(LogicalType::VARCHAR)};
+	read_xlsx_set.AddFunction(read_xlsx);
+
+	loader.RegisterFunction(read_xlsx_set);
+
+	auto &config = loader.GetDatabaseInstance().config;
+	config.replacement_scans.emplace_back(XLSXReplacementScan);
+	config.AddExtensionOption("xlsx_fast_sheet_parser",
+	                          "Tokenize the rows of xlsx sheets directly instead of parsing them with a generic XML "
+	                          "parser. Disable to parse the whole sheet with expat, for sheets the tokenizer reads "
+	                          "incorrectly.",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("xlsx_inflate_buffer_size",
+	                          "The largest (uncompressed) size of an entry in an xlsx file that is inflated into "
+	                          "memory in a single pass instead of being streamed. 0 streams every entry.",
+	                          LogicalType::UBIGINT, Value::UBIGINT(ZipFileReader::DEFAULT_INFLATE_BUFFER_SIZE));
+	config.AddExtensionOption("xlsx_memory_map",
+	                          "Memory map local xlsx files, so that stored entries are parsed straight from the mapped "
+	                          "file. The file must not be truncated while it is being read.",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
 }
 
 } // namespace duckdb
\ No newline at end of file
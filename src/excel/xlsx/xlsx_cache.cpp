@@ -0,0 +1,383 @@
+#include "xlsx/xlsx_cache.hpp"
+
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/function/pragma_function.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "xlsx/parsers/shared_strings_parser.hpp"
+#include "xlsx/zip_file.hpp"
+
+namespace duckdb {
+
+//-------------------------------------------------------------------
+// Metadata Cache
+//-------------------------------------------------------------------
+static constexpr idx_t XLSX_DEFAULT_METADATA_CACHE_SIZE = 64;
+
+shared_ptr<XLSXMetadataCache> XLSXMetadataCache::Get(ClientContext &context) {
+	idx_t capacity = XLSX_DEFAULT_METADATA_CACHE_SIZE;
+	Value setting;
+	if (context.TryGetCurrentSetting("xlsx_metadata_cache_size", setting) && !setting.IsNull()) {
+		capacity = UBigIntValue::Get(setting);
+	}
+
+	auto &object_cache = ObjectCache::GetObjectCache(context);
+	if (capacity == 0) {
+		// Disabled, drop anything that was cached before
+		auto cache = object_cache.Get<XLSXMetadataCache>(ObjectType());
+		if (cache) {
+			cache->SetCapacity(0);
+		}
+		return nullptr;
+	}
+	auto cache = object_cache.GetOrCreate<XLSXMetadataCache>(ObjectType());
+	cache->SetCapacity(capacity);
+	return cache;
+}
+
+shared_ptr<const XLSXWorkbookMetadata> XLSXMetadataCache::Lookup(const string &file_path, const hash_t fingerprint) {
+	lock_guard<mutex> guard(lock);
+	const auto found = index.find(file_path);
+	if (found == index.end()) {
+		return nullptr;
+	}
+	const auto entry = found->second;
+	if (entry->fingerprint != fingerprint) {
+		// The file changed, the entry is of no use anymore
+		entries.erase(entry);
+		index.erase(found);
+		return nullptr;
+	}
+	entries.splice(entries.begin(), entries, entry);
+	return entry->metadata;
+}
+
+void XLSXMetadataCache::Store(const string &file_path, const hash_t fingerprint,
+                              shared_ptr<const XLSXWorkbookMetadata> metadata) {
+	lock_guard<mutex> guard(lock);
+	if (capacity == 0) {
+		return;
+	}
+	const auto found = index.find(file_path);
+	if (found != index.end()) {
+		entries.erase(found->second);
+		index.erase(found);
+	}
+	entries.push_front(Entry {file_path, fingerprint, std::move(metadata)});
+	index[file_path] = entries.begin();
+	while (entries.size() > capacity) {
+		index.erase(entries.back().file_path);
+		entries.pop_back();
+	}
+}
+
+vector<XLSXMetadataCache::Entry> XLSXMetadataCache::GetEntries() {
+	lock_guard<mutex> guard(lock);
+	return vector<Entry>(entries.begin(), entries.end());
+}
+
+void XLSXMetadataCache::SetCapacity(const idx_t capacity_p) {
+	lock_guard<mutex> guard(lock);
+	capacity = capacity_p;
+	while (entries.size() > capacity) {
+		index.erase(entries.back().file_path);
+		entries.pop_back();
+	}
+}
+
+//-------------------------------------------------------------------
+// Shared String Cache
+//-------------------------------------------------------------------
+shared_ptr<const StringTable> XLSXSharedStringsCacheEntry::Load(ClientContext &context, const string &file_path,
+                                                                ZipFileReader &archive) {
+	auto is_binary = false;
+	auto entry_idx = archive.FindEntry(XLSX_SHARED_STRINGS_ENTRY);
+	if (entry_idx == DConstants::INVALID_INDEX) {
+		// Binary workbooks keep their strings in records
+		is_binary = true;
+		entry_idx = archive.FindEntry(XLSB_SHARED_STRINGS_ENTRY);
+	}
+	if (entry_idx == DConstants::INVALID_INDEX) {
+		return nullptr;
+	}
+	const auto fingerprint = CombineHash(archive.GetFingerprint(), Hash<uint32_t>(archive.GetEntryCRC(entry_idx)));
+
+	// Only one table is cached per file, a table parsed from an older version of the file is replaced
+	const auto key = ObjectType() + ":" + file_path;
+	auto &object_cache = ObjectCache::GetObjectCache(context);
+	const auto cached = object_cache.Get<XLSXSharedStringsCacheEntry>(key);
+	if (cached && cached->fingerprint == fingerprint) {
+		return cached->strings;
+	}
+
+	if (!archive.TryOpenEntry(is_binary ? XLSB_SHARED_STRINGS_ENTRY : XLSX_SHARED_STRINGS_ENTRY)) {
+		return nullptr;
+	}
+	auto strings = make_shared_ptr<StringTable>(BufferAllocator::Get(context));
+	SharedStringParser::ParseStringTable(archive, *strings, is_binary);
+	archive.CloseEntry();
+
+	shared_ptr<const StringTable> result = std::move(strings);
+	object_cache.Put(key, make_shared_ptr<XLSXSharedStringsCacheEntry>(fingerprint, result));
+	return result;
+}
+
+//-------------------------------------------------------------------
+// Sheet Index Cache
+//-------------------------------------------------------------------
+const XLSXSheetCheckpoint *XLSXSheetIndex::FindCheckpoint(const idx_t row_number) const {
+	const XLSXSheetCheckpoint *result = nullptr;
+	for (auto &checkpoint : checkpoints) {
+		if (checkpoint.row_number > row_number) {
+			break;
+		}
+		result = &checkpoint;
+	}
+	return result;
+}
+
+idx_t XLSXSheetIndex::GetMemoryUsage() const {
+	idx_t result = 0;
+	for (auto &checkpoint : checkpoints) {
+		result += sizeof(XLSXSheetCheckpoint) + checkpoint.inflate.window.size();
+	}
+	return result;
+}
+
+static string GetSheetIndexKey(const string &file_path, const string &sheet_path) {
+	return XLSXSheetIndexCacheEntry::ObjectType() + ":" + file_path + ":" + sheet_path;
+}
+
+shared_ptr<const XLSXSheetIndex> XLSXSheetIndexCacheEntry::Lookup(ClientContext &context, const string &file_path,
+                                                                  const string &sheet_path, const hash_t fingerprint) {
+	auto &object_cache = ObjectCache::GetObjectCache(context);
+	const auto cached = object_cache.Get<XLSXSheetIndexCacheEntry>(GetSheetIndexKey(file_path, sheet_path));
+	if (!cached || cached->fingerprint != fingerprint) {
+		return nullptr;
+	}
+	return cached->index;
+}
+
+void XLSXSheetIndexCacheEntry::Store(ClientContext &context, const string &file_path, const string &sheet_path,
+                                     const hash_t fingerprint, shared_ptr<const XLSXSheetIndex> index) {
+	if (index->checkpoints.empty()) {
+		return;
+	}
+	// Only one index is cached per sheet, an index of an older version of the file is replaced
+	const auto key = GetSheetIndexKey(file_path, sheet_path);
+	auto &object_cache = ObjectCache::GetObjectCache(context);
+	const auto cached = object_cache.Get<XLSXSheetIndexCacheEntry>(key);
+	if (cached && cached->fingerprint == fingerprint &&
+	    cached->index->checkpoints.size() >= index->checkpoints.size()) {
+		return;
+	}
+	object_cache.Put(key, make_shared_ptr<XLSXSheetIndexCacheEntry>(fingerprint, std::move(index)));
+}
+
+//-------------------------------------------------------------------
+// Result Cache
+//-------------------------------------------------------------------
+shared_ptr<XLSXResultCache> XLSXResultCache::Get(ClientContext &context) {
+	Value setting;
+	const auto enabled = context.TryGetCurrentSetting("xlsx_result_cache", setting) && !setting.IsNull() &&
+	                     BooleanValue::Get(setting);
+
+	auto &object_cache = ObjectCache::GetObjectCache(context);
+	if (!enabled) {
+		// Disabled, drop anything that was cached before
+		auto cache = object_cache.Get<XLSXResultCache>(ObjectType());
+		if (cache) {
+			cache->Clear();
+		}
+		return nullptr;
+	}
+	return object_cache.GetOrCreate<XLSXResultCache>(ObjectType());
+}
+
+shared_ptr<const ColumnDataCollection> XLSXResultCache::Lookup(const string &key, const hash_t fingerprint) {
+	lock_guard<mutex> guard(lock);
+	const auto found = index.find(key);
+	if (found == index.end()) {
+		return nullptr;
+	}
+	const auto entry = found->second;
+	if (entry->fingerprint != fingerprint) {
+		// The file changed, the entry is of no use anymore
+		size -= entry->rows->SizeInBytes();
+		entries.erase(entry);
+		index.erase(found);
+		return nullptr;
+	}
+	entries.splice(entries.begin(), entries, entry);
+	return entry->rows;
+}
+
+void XLSXResultCache::Store(ClientContext &context, const string &key, const string &file_path,
+                            const string &sheet_name, const hash_t fingerprint,
+                            shared_ptr<const ColumnDataCollection> rows) {
+	// Leave enough room for everything else
+	const auto capacity = BufferManager::GetBufferManager(context).GetMaxMemory() / 4;
+	const auto rows_size = rows->SizeInBytes();
+	if (rows_size > capacity) {
+		return;
+	}
+
+	lock_guard<mutex> guard(lock);
+	const auto found = index.find(key);
+	if (found != index.end()) {
+		size -= found->second->rows->SizeInBytes();
+		entries.erase(found->second);
+		index.erase(found);
+	}
+	entries.push_front(Entry {key, file_path, sheet_name, fingerprint, std::move(rows)});
+	index[key] = entries.begin();
+	size += rows_size;
+	while (size > capacity) {
+		size -= entries.back().rows->SizeInBytes();
+		index.erase(entries.back().key);
+		entries.pop_back();
+	}
+}
+
+void XLSXResultCache::Clear() {
+	lock_guard<mutex> guard(lock);
+	entries.clear();
+	index.clear();
+	size = 0;
+}
+
+vector<XLSXResultCache::Entry> XLSXResultCache::GetEntries() {
+	lock_guard<mutex> guard(lock);
+	return vector<Entry>(entries.begin(), entries.end());
+}
+
+//-------------------------------------------------------------------
+// xlsx_metadata_cache()
+//-------------------------------------------------------------------
+class XLSXMetadataCacheState final : public GlobalTableFunctionState {
+public:
+	vector<XLSXMetadataCache::Entry> entries;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> MetadataCacheBind(ClientContext &context, TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("file_path");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("sheets");
+	return_types.emplace_back(LogicalType::LIST(LogicalType::VARCHAR));
+	names.emplace_back("sniffed_schemas");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	return nullptr;
+}
+
+static unique_ptr<GlobalTableFunctionState> MetadataCacheInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<XLSXMetadataCacheState>();
+	auto cache = ObjectCache::GetObjectCache(context).Get<XLSXMetadataCache>(XLSXMetadataCache::ObjectType());
+	if (cache) {
+		result->entries = cache->GetEntries();
+	}
+	return std::move(result);
+}
+
+static void MetadataCacheExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<XLSXMetadataCacheState>();
+	idx_t count = 0;
+	while (state.offset < state.entries.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &entry = state.entries[state.offset++];
+		vector<Value> sheets;
+		for (auto &sheet : entry.metadata->sheets) {
+			sheets.emplace_back(sheet.first);
+		}
+		output.SetValue(0, count, Value(entry.file_path));
+		output.SetValue(1, count, Value::LIST(LogicalType::VARCHAR, std::move(sheets)));
+		output.SetValue(2, count, Value::UBIGINT(entry.metadata->schemas.size()));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+//-------------------------------------------------------------------
+// xlsx_result_cache()
+//-------------------------------------------------------------------
+class XLSXResultCacheState final : public GlobalTableFunctionState {
+public:
+	vector<XLSXResultCache::Entry> entries;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> ResultCacheBind(ClientContext &context, TableFunctionBindInput &input,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("file_path");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("sheet");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("row_count");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("size_bytes");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	return nullptr;
+}
+
+static unique_ptr<GlobalTableFunctionState> ResultCacheInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<XLSXResultCacheState>();
+	auto cache = ObjectCache::GetObjectCache(context).Get<XLSXResultCache>(XLSXResultCache::ObjectType());
+	if (cache) {
+		result->entries = cache->GetEntries();
+	}
+	return std::move(result);
+}
+
+static void ResultCacheExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<XLSXResultCacheState>();
+	idx_t count = 0;
+	while (state.offset < state.entries.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &entry = state.entries[state.offset++];
+		output.SetValue(0, count, Value(entry.file_path));
+		output.SetValue(1, count, Value(entry.sheet_name));
+		output.SetValue(2, count, Value::UBIGINT(entry.rows->Count()));
+		output.SetValue(3, count, Value::UBIGINT(entry.rows->SizeInBytes()));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+static string PragmaResultCache(ClientContext &context, const FunctionParameters &parameters) {
+	return "SELECT * FROM xlsx_result_cache();";
+}
+
+static void PragmaClearResultCache(ClientContext &context, const FunctionParameters &parameters) {
+	auto cache = ObjectCache::GetObjectCache(context).Get<XLSXResultCache>(XLSXResultCache::ObjectType());
+	if (cache) {
+		cache->Clear();
+	}
+}
+
+//-------------------------------------------------------------------
+// Register
+//-------------------------------------------------------------------
+void XLSXCache::Register(ExtensionLoader &loader) {
+	TableFunction metadata_cache("xlsx_metadata_cache", {}, MetadataCacheExecute, MetadataCacheBind,
+	                             MetadataCacheInit);
+	loader.RegisterFunction(metadata_cache);
+
+	TableFunction result_cache("xlsx_result_cache", {}, ResultCacheExecute, ResultCacheBind, ResultCacheInit);
+	loader.RegisterFunction(result_cache);
+	loader.RegisterFunction(PragmaFunction::PragmaStatement("xlsx_result_cache", PragmaResultCache));
+	loader.RegisterFunction(PragmaFunction::PragmaStatement("xlsx_clear_result_cache", PragmaClearResultCache));
+
+	auto &config = loader.GetDatabaseInstance().config;
+	config.AddExtensionOption("xlsx_metadata_cache_size",
+	                          "The maximum number of workbooks whose sheets, styles and sniffed schemas are cached "
+	                          "across queries. 0 disables the cache.",
+	                          LogicalType::UBIGINT, Value::UBIGINT(XLSX_DEFAULT_METADATA_CACHE_SIZE));
+	config.AddExtensionOption("xlsx_result_cache",
+	                          "Cache the decoded rows of read_xlsx scans, so that scanning an unchanged sheet again "
+	                          "doesn't have to parse it. Disabling the cache drops everything in it.",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+}
+
+} // namespace duckdb
@@ -1,7 +1,14 @@
 #include "xlsx/zip_file.hpp"
 #include "xlsx/xml_util.hpp"
 
+#include "duckdb/common/error_data.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 #include "minizip-ng/mz.h"
 #include "minizip-ng/mz_os.h"
@@ -9,6 +16,17 @@
 #include "minizip-ng/mz_zip.h"
 #include "minizip-ng/mz_zip_rw.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <zlib.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace duckdb {
 
 //-------------------------------------------------------------------------
@@ -47,6 +65,12 @@ struct mz_stream_duckdb {
 	FileSystem *fs;
 	FileHandle *handle;
 	string last_error;
+	// The end of the file, read at once when a zip is opened for reading (see ReadArchiveTail)
+	idx_t tail_pos;
+	string tail;
+	// The bytes read from and written to the file
+	idx_t bytes_read;
+	idx_t bytes_written;
 };
 
 int32_t mz_stream_duckdb_open(void *stream, const char *path, int32_t mode) {
@@ -58,6 +82,10 @@ int32_t mz_stream_duckdb_open(void *stream, const char *path, int32_t mode) {
 		self.handle = nullptr;
 		self.last_error.clear();
 	}
+	self.tail_pos = 0;
+	self.tail.clear();
+	self.bytes_read = 0;
+	self.bytes_written = 0;
 
 	FileOpenFlags flags = 0;
 	if (mode & MZ_OPEN_MODE_READ) {
@@ -99,12 +127,30 @@ int32_t mz_stream_duckdb_is_open(void *stream) {
 
 int32_t mz_stream_duckdb_read(void *stream, void *buf, int32_t size) {
 	auto &self = *reinterpret_cast<mz_stream_duckdb *>(stream);
-	return self.handle->Read(buf, size);
+	if (!self.tail.empty() && size > 0) {
+		// Serve reads of the central directory from the tail
+		const auto pos = self.handle->SeekPosition();
+		const auto end = pos + static_cast<idx_t>(size);
+		if (pos >= self.tail_pos && end <= self.tail_pos + self.tail.size()) {
+			memcpy(buf, self.tail.data() + (pos - self.tail_pos), static_cast<size_t>(size));
+			self.handle->Seek(end);
+			return size;
+		}
+	}
+	const auto bytes_read = self.handle->Read(buf, size);
+	if (bytes_read > 0) {
+		self.bytes_read += static_cast<idx_t>(bytes_read);
+	}
+	return bytes_read;
 }
 
 int32_t mz_stream_duckdb_write(void *stream, const void *buf, int32_t size) {
 	auto &self = *reinterpret_cast<mz_stream_duckdb *>(stream);
-	return self.handle->Write(const_cast<void *>(buf), size);
+	const auto bytes_written = self.handle->Write(const_cast<void *>(buf), size);
+	if (bytes_written > 0) {
+		self.bytes_written += static_cast<idx_t>(bytes_written);
+	}
+	return bytes_written;
 }
 
 int64_t mz_stream_duckdb_tell(void *stream) {
@@ -138,6 +184,7 @@ int32_t mz_stream_duckdb_close(void *stream) {
 	self.handle->~FileHandle();
 	self.handle = nullptr;
 	self.last_error.clear();
+	self.tail.clear();
 	return MZ_OK;
 }
 
@@ -150,6 +197,9 @@ int32_t mz_stream_duckdb_error(void *stream) {
 void *mz_stream_duckdb_create(void) {
 	auto stream = new mz_stream_duckdb();
 	stream->base.vtbl = &mz_duckdb_file_stream_vtable;
+	stream->tail_pos = 0;
+	stream->bytes_read = 0;
+	stream->bytes_written = 0;
 	return stream;
 }
 
@@ -169,6 +219,746 @@ void mz_stream_duckdb_delete(void **stream) {
 }
 // NOLINTEND
 
+// The end of central directory record is at most 22 bytes plus a 64KB comment from the end of the file
+static constexpr idx_t ZIP_TAIL_SIZE = 22 + 65535;
+// Larger central directories are read by minizip as usual
+static constexpr idx_t ZIP_MAX_TAIL_SIZE = 16ULL * 1024 * 1024;
+
+static uint32_t LoadLE32(const char *ptr) {
+	const auto bytes = const_data_ptr_cast(ptr);
+	return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+	       static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+// Read the end of the file, including the central directory if it is not too large, with a single read (or two, if
+// the central directory doesn't fit in the first one). Indexing the entries then doesn't need any more reads, which
+// adds up for remote files.
+static void ReadArchiveTail(mz_stream_duckdb &stream) {
+	auto &file = *stream.handle;
+	const auto file_size = file.GetFileSize();
+	auto tail_pos = file_size - MinValue(file_size, ZIP_TAIL_SIZE);
+	string tail(file_size - tail_pos, '\0');
+	if (tail.empty()) {
+		return;
+	}
+	file.Read(&tail[0], tail.size(), tail_pos);
+	stream.bytes_read += tail.size();
+
+	// Find the end of central directory record, and from it the central directory
+	for (auto record_pos = static_cast<int64_t>(tail.size()) - 22; record_pos >= 0; record_pos--) {
+		const auto record = tail.data() + record_pos;
+		if (record[0] != 'P' || record[1] != 'K' || record[2] != 5 || record[3] != 6) {
+			continue;
+		}
+		const auto directory_pos = static_cast<idx_t>(LoadLE32(record + 16));
+		if (directory_pos < tail_pos && file_size - directory_pos <= ZIP_MAX_TAIL_SIZE) {
+			// Read the rest of the central directory in front of the tail
+			string directory(tail_pos - directory_pos, '\0');
+			file.Read(&directory[0], directory.size(), directory_pos);
+			stream.bytes_read += directory.size();
+			tail = directory + tail;
+			tail_pos = directory_pos;
+		}
+		break;
+	}
+	stream.tail = std::move(tail);
+	stream.tail_pos = tail_pos;
+}
+
+//-------------------------------------------------------------------------
+// Archive Source
+//-------------------------------------------------------------------------
+// Where our decoders read the data of the entries from: either the file
+// handle, or a read-only memory mapping of the whole file, in which case
+// nothing is copied out of the page cache at all. Entries that are about
+// to be read can be prefetched with a few large reads, and entries in
+// remote files are streamed with a read-ahead on a background thread.
+//-------------------------------------------------------------------------
+class ZipFileMapping {
+public:
+	// Map a local file, or return nullptr if it can't be mapped
+	static unique_ptr<ZipFileMapping> TryMap(FileHandle &file);
+	~ZipFileMapping();
+
+	// Delete copy
+	ZipFileMapping(const ZipFileMapping &) = delete;
+	ZipFileMapping &operator=(const ZipFileMapping &) = delete;
+
+	const_data_ptr_t data;
+	idx_t size;
+
+private:
+	ZipFileMapping(const_data_ptr_t data_p, idx_t size_p) : data(data_p), size(size_p) {
+	}
+};
+
+unique_ptr<ZipFileMapping> ZipFileMapping::TryMap(FileHandle &file) {
+#ifdef _WIN32
+	return nullptr;
+#else
+	const auto &path = file.GetPath();
+	if (file.file_system.GetName() != "LocalFileSystem" || StringUtil::StartsWith(path, "file:")) {
+		return nullptr;
+	}
+	const auto size = file.GetFileSize();
+	if (size == 0) {
+		return nullptr;
+	}
+	const auto fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return nullptr;
+	}
+	struct stat file_stat;
+	void *data = MAP_FAILED;
+	if (fstat(fd, &file_stat) == 0 && NumericCast<idx_t>(file_stat.st_size) == size) {
+		data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+	return unique_ptr<ZipFileMapping>(new ZipFileMapping(static_cast<const_data_ptr_t>(data), size));
+#endif
+}
+
+ZipFileMapping::~ZipFileMapping() {
+#ifndef _WIN32
+	munmap(const_cast<data_ptr_t>(data), size);
+#endif
+}
+
+// Ranges of the file that are read together if they are at most this far apart
+static constexpr idx_t ZIP_PREFETCH_GAP = 64ULL * 1024;
+// The size of the reads issued ahead of the inflater for remote files
+static constexpr idx_t ZIP_READ_AHEAD_SIZE = 1024ULL * 1024;
+
+class ZipFileSource {
+public:
+	ZipFileSource(FileHandle &file_p, const ZipFileMapping *mapping_p, TaskScheduler &scheduler_p)
+	    : file(file_p), mapping(mapping_p), scheduler(scheduler_p) {
+	}
+
+	// Get `size` bytes at `pos` in the file, either pointing into the mapping or a prefetched range, or read into
+	// the buffer
+	const_data_ptr_t Read(data_ptr_t buffer, idx_t size, idx_t pos);
+	// Read the given (position, size) ranges of the file with as few reads as possible, and keep them in memory
+	void Prefetch(vector<pair<idx_t, idx_t>> ranges);
+
+	bool IsMapped() const {
+		return mapping != nullptr;
+	}
+	// Whether reads are expensive enough to read ahead of the inflater
+	bool IsRemote() const {
+		return !mapping && !file.OnDiskFile();
+	}
+	FileHandle &GetFile() const {
+		return file;
+	}
+	TaskScheduler &GetScheduler() const {
+		return scheduler;
+	}
+
+	// The bytes read from the file (or the mapping) so far, including the reads of read-aheads
+	idx_t bytes_read = 0;
+
+private:
+	FileHandle &file;
+	const ZipFileMapping *mapping;
+	TaskScheduler &scheduler;
+
+	struct PrefetchedRange {
+		idx_t pos;
+		idx_t size;
+		unsafe_unique_array<data_t> data;
+	};
+	vector<PrefetchedRange> prefetched;
+};
+
+const_data_ptr_t ZipFileSource::Read(const data_ptr_t buffer, const idx_t size, const idx_t pos) {
+	if (mapping) {
+		if (pos + size > mapping->size) {
+			throw IOException("Failed to read entry: unexpected end of file");
+		}
+		bytes_read += size;
+		return mapping->data + pos;
+	}
+	for (auto &range : prefetched) {
+		if (pos >= range.pos && pos + size <= range.pos + range.size) {
+			return range.data.get() + (pos - range.pos);
+		}
+	}
+	file.Read(buffer, size, pos);
+	bytes_read += size;
+	return buffer;
+}
+
+void ZipFileSource::Prefetch(vector<pair<idx_t, idx_t>> ranges) {
+	if (mapping || ranges.empty()) {
+		return;
+	}
+	const auto file_size = file.GetFileSize();
+	std::sort(ranges.begin(), ranges.end());
+	idx_t range_idx = 0;
+	while (range_idx < ranges.size()) {
+		// Merge the ranges that are close enough to the next one
+		const auto beg = MinValue(ranges[range_idx].first, file_size);
+		auto end = MinValue(beg + ranges[range_idx].second, file_size);
+		for (range_idx++; range_idx < ranges.size() && ranges[range_idx].first <= end + ZIP_PREFETCH_GAP; range_idx++) {
+			end = MaxValue(end, MinValue(ranges[range_idx].first + ranges[range_idx].second, file_size));
+		}
+		if (beg == end) {
+			continue;
+		}
+		PrefetchedRange range {beg, end - beg, make_unsafe_uniq_array_uninitialized<data_t>(end - beg)};
+		file.Read(range.data.get(), range.size, range.pos);
+		bytes_read += range.size;
+		prefetched.push_back(std::move(range));
+	}
+}
+
+// A read of the next chunk of a read-ahead. It is scheduled as a task, so that it runs on one of DuckDB's worker
+// threads and is bounded by the `threads` setting. If no worker got to it by the time the chunk is needed, the reader
+// runs it itself, so the read never waits on a busy scheduler (or one without any workers).
+class ZipPendingRead {
+public:
+	ZipPendingRead(FileHandle &file_p, data_ptr_t buffer_p, idx_t size_p, idx_t pos_p)
+	    : file(file_p), buffer(buffer_p), size(size_p), pos(pos_p) {
+	}
+
+	// Run the read, unless it already started or was cancelled
+	void TryRun();
+	// Wait for the read, running it if it didn't start yet, and rethrow if it failed
+	void Finish();
+	// Make sure the read doesn't touch the file or the buffer anymore, either by cancelling it or by waiting for it
+	void Cancel();
+
+private:
+	enum class State : uint8_t { QUEUED, RUNNING, DONE, CANCELLED };
+
+	FileHandle &file;
+	data_ptr_t buffer;
+	idx_t size;
+	idx_t pos;
+
+	mutex lock;
+	std::condition_variable done;
+	State state = State::QUEUED;
+	ErrorData error;
+};
+
+void ZipPendingRead::TryRun() {
+	{
+		lock_guard<mutex> guard(lock);
+		if (state != State::QUEUED) {
+			return;
+		}
+		state = State::RUNNING;
+	}
+	ErrorData read_error;
+	try {
+		file.Read(buffer, size, pos);
+	} catch (std::exception &ex) {
+		read_error = ErrorData(ex);
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		error = std::move(read_error);
+		state = State::DONE;
+	}
+	done.notify_all();
+}
+
+void ZipPendingRead::Finish() {
+	TryRun();
+	unique_lock<mutex> guard(lock);
+	done.wait(guard, [&]() { return state == State::DONE; });
+	if (error.HasError()) {
+		error.Throw();
+	}
+}
+
+void ZipPendingRead::Cancel() {
+	unique_lock<mutex> guard(lock);
+	if (state == State::QUEUED) {
+		state = State::CANCELLED;
+		return;
+	}
+	done.wait(guard, [&]() { return state != State::RUNNING; });
+}
+
+class ZipReadAheadTask final : public Task {
+public:
+	explicit ZipReadAheadTask(shared_ptr<ZipPendingRead> read_p) : read(std::move(read_p)) {
+	}
+
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		read->TryRun();
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+
+	string TaskType() const override {
+		return "ZipReadAheadTask";
+	}
+
+private:
+	shared_ptr<ZipPendingRead> read;
+};
+
+// Reads a range of the file front to back, always reading the next chunk in the background while the current one is
+// consumed. The file must not be read by anything else while a read is in flight, which holds as long as the entry is
+// open: the reader only touches the file again after the decoder (and with it this) is destroyed.
+class ZipReadAhead {
+public:
+	ZipReadAhead(FileHandle &file_p, TaskScheduler &scheduler_p, const idx_t pos, const idx_t end_p)
+	    : file(file_p), scheduler(scheduler_p), producer(scheduler.CreateProducer()), next_pos(pos), end(end_p),
+	      buffers {make_unsafe_uniq_array_uninitialized<data_t>(ZIP_READ_AHEAD_SIZE),
+	               make_unsafe_uniq_array_uninitialized<data_t>(ZIP_READ_AHEAD_SIZE)} {
+	}
+	~ZipReadAhead() {
+		CancelPending();
+	}
+
+	// Get the next chunk of the range, which stays valid until the next call. Returns 0 at the end of the range.
+	idx_t Next(const_data_ptr_t &chunk);
+	// Continue reading at another position
+	void Seek(idx_t pos);
+
+private:
+	// Start reading the next chunk into the given buffer
+	void ReadNext(idx_t buffer_idx, bool async);
+	// Cancel the read in flight (or wait for it), and take its task off the queue if no worker picked it up
+	void CancelPending();
+	// Take the task of a read that is done or cancelled off the queue, if it is still queued
+	void DropTask();
+
+	FileHandle &file;
+	TaskScheduler &scheduler;
+	unique_ptr<ProducerToken> producer;
+	idx_t next_pos;
+	idx_t end;
+	unsafe_unique_array<data_t> buffers[2];
+	idx_t sizes[2] = {0, 0};
+	// The buffer that is being read into (or was read into last)
+	idx_t back = 0;
+	shared_ptr<ZipPendingRead> pending;
+};
+
+void ZipReadAhead::ReadNext(const idx_t buffer_idx, const bool async) {
+	const auto pos = next_pos;
+	const auto size = MinValue(ZIP_READ_AHEAD_SIZE, end - next_pos);
+	const auto buffer = buffers[buffer_idx].get();
+	next_pos += size;
+	sizes[buffer_idx] = size;
+	if (!async) {
+		file.Read(buffer, size, pos);
+		return;
+	}
+	pending = make_shared_ptr<ZipPendingRead>(file, buffer, size, pos);
+	scheduler.ScheduleTask(*producer, make_shared_ptr<ZipReadAheadTask>(pending));
+}
+
+void ZipReadAhead::CancelPending() {
+	if (pending) {
+		pending->Cancel();
+		pending.reset();
+	}
+	DropTask();
+}
+
+void ZipReadAhead::DropTask() {
+	shared_ptr<Task> task;
+	while (scheduler.GetTaskFromProducer(*producer, task)) {
+		task.reset();
+	}
+}
+
+idx_t ZipReadAhead::Next(const_data_ptr_t &chunk) {
+	if (pending) {
+		// Wait for the chunk we read ahead, and rethrow if reading it failed
+		auto read = std::move(pending);
+		read->Finish();
+		DropTask();
+	} else {
+		if (next_pos >= end) {
+			return 0;
+		}
+		ReadNext(back, false);
+	}
+	const auto front = back;
+	back = 1 - back;
+	if (next_pos < end) {
+		ReadNext(back, true);
+	}
+	chunk = buffers[front].get();
+	return sizes[front];
+}
+
+void ZipReadAhead::Seek(const idx_t pos) {
+	CancelPending();
+	next_pos = MinValue(pos, end);
+}
+
+//-------------------------------------------------------------------------
+// Entry Decoders
+//-------------------------------------------------------------------------
+// Deflated and stored entries are decoded straight from the file (or
+// its mapping) instead of going through minizip. Deflated entries that
+// fit in the inflate buffer budget are inflated into memory in a single
+// pass, which lets zlib skip maintaining its sliding window. Larger
+// entries, and entries that are read to record or resume from
+// checkpoints, are streamed. Encrypted entries are left to minizip.
+//-------------------------------------------------------------------------
+class ZipEntryDecoder {
+public:
+	virtual ~ZipEntryDecoder() = default;
+
+	// Read the next uncompressed bytes of the entry into the buffer. Returns 0 at the end of the entry.
+	virtual idx_t Read(char *buffer, idx_t read_size) = 0;
+	// Get the next uncompressed bytes of the entry, either read into the buffer or pointing into memory held by the
+	// decoder (which stays valid until the next read). Returns 0 at the end of the entry.
+	virtual idx_t ReadBlock(char *buffer, idx_t read_size, const char *&block) {
+		block = buffer;
+		return Read(buffer, read_size);
+	}
+	// Whether the data read so far matches the CRC of the entry, as far as that can be checked
+	virtual bool CheckCRC() const = 0;
+
+	// Continue at a checkpoint recorded for the same entry. Returns false if the decoder can't resume.
+	virtual bool TryResume(const ZipInflateCheckpoint &checkpoint) {
+		return false;
+	}
+	// The checkpoints recorded so far
+	virtual const vector<ZipInflateCheckpoint> &GetCheckpoints() const {
+		static const vector<ZipInflateCheckpoint> no_checkpoints;
+		return no_checkpoints;
+	}
+};
+
+//-------------------------------------------------------------------------
+// Streaming Inflater
+//-------------------------------------------------------------------------
+// Inflates an entry straight into the buffer of the reader, a block at
+// a time, so that it can stop at the boundaries of the deflate blocks
+// to record checkpoints, and resume from them later. This follows
+// zlib's zran example.
+//-------------------------------------------------------------------------
+class ZipEntryInflater final : public ZipEntryDecoder {
+public:
+	ZipEntryInflater(ZipFileSource &source, idx_t data_pos, idx_t data_len, uint32_t entry_crc,
+	                 idx_t checkpoint_span);
+	~ZipEntryInflater() override;
+
+	// Delete copy
+	ZipEntryInflater(const ZipEntryInflater &) = delete;
+	ZipEntryInflater &operator=(const ZipEntryInflater &) = delete;
+
+	bool TryResume(const ZipInflateCheckpoint &checkpoint) override;
+	idx_t Read(char *buffer, idx_t read_size) override;
+
+	// Whether the inflated data matches the CRC of the entry. Can only be checked once the whole entry was read
+	// from the beginning.
+	bool CheckCRC() const override {
+		return is_resumed || !is_done || crc == entry_crc;
+	}
+
+	const vector<ZipInflateCheckpoint> &GetCheckpoints() const override {
+		return checkpoints;
+	}
+
+private:
+	vector<ZipInflateCheckpoint> checkpoints;
+
+	void ReadInput();
+	void AddCheckpoint();
+
+	static constexpr idx_t WINDOW_SIZE = 32768;
+	static constexpr idx_t INPUT_SIZE = 65536;
+
+	ZipFileSource &source;
+	// The position and size of the compressed data in the file
+	idx_t data_pos;
+	idx_t data_len;
+	// How much of the compressed data has been read, and how much data has been inflated
+	idx_t in_pos = 0;
+	idx_t out_pos = 0;
+
+	z_stream strm;
+	// Only needed if the file is not mapped, or read ahead if it is remote
+	unsafe_unique_array<Bytef> input;
+	unique_ptr<ZipReadAhead> read_ahead;
+
+	idx_t checkpoint_span;
+	idx_t last_checkpoint = 0;
+	uint32_t entry_crc;
+	uint32_t crc = 0;
+	bool is_resumed = false;
+	bool is_done = false;
+};
+
+ZipEntryInflater::ZipEntryInflater(ZipFileSource &source_p, const idx_t data_pos_p, const idx_t data_len_p,
+                                   const uint32_t entry_crc_p, const idx_t checkpoint_span_p)
+    : source(source_p), data_pos(data_pos_p), data_len(data_len_p), checkpoint_span(checkpoint_span_p),
+      entry_crc(entry_crc_p) {
+	if (source.IsRemote()) {
+		read_ahead = make_uniq<ZipReadAhead>(source.GetFile(), source.GetScheduler(), data_pos, data_pos + data_len);
+	} else if (!source.IsMapped()) {
+		input = make_unsafe_uniq_array_uninitialized<Bytef>(INPUT_SIZE);
+	}
+	memset(&strm, 0, sizeof(strm));
+	// Raw deflate data, without a zlib header
+	if (inflateInit2(&strm, -15) != Z_OK) {
+		throw IOException("Failed to initialize inflater");
+	}
+}
+
+ZipEntryInflater::~ZipEntryInflater() {
+	inflateEnd(&strm);
+}
+
+void ZipEntryInflater::ReadInput() {
+	if (read_ahead) {
+		const_data_ptr_t chunk;
+		const auto chunk_size = read_ahead->Next(chunk);
+		strm.next_in = const_cast<Bytef *>(chunk);
+		strm.avail_in = static_cast<uInt>(chunk_size);
+		in_pos += chunk_size;
+		source.bytes_read += chunk_size;
+		return;
+	}
+	// Mapped data is inflated in place, in steps that fit zlib's 32-bit sizes
+	const auto max_size = source.IsMapped() ? static_cast<idx_t>(NumericLimits<uInt>::Maximum()) : INPUT_SIZE;
+	const auto read_size = MinValue(max_size, data_len - in_pos);
+	if (read_size == 0) {
+		// The inflater may still have output pending
+		return;
+	}
+	strm.next_in = const_cast<Bytef *>(source.Read(input.get(), read_size, data_pos + in_pos));
+	strm.avail_in = static_cast<uInt>(read_size);
+	in_pos += read_size;
+}
+
+bool ZipEntryInflater::TryResume(const ZipInflateCheckpoint &checkpoint) {
+	if (inflateReset(&strm) != Z_OK) {
+		throw IOException("Failed to reset inflater");
+	}
+	strm.avail_in = 0;
+	in_pos = checkpoint.in_pos;
+	if (read_ahead) {
+		// Also waits for the read in flight, so that the file is not read from two threads
+		read_ahead->Seek(data_pos + in_pos);
+	}
+	if (checkpoint.in_bits) {
+		// The checkpoint is in the middle of a byte, feed the bits of it that are left
+		in_pos--;
+		Bytef byte;
+		const auto byte_ptr = source.Read(&byte, 1, data_pos + in_pos);
+		in_pos++;
+		if (inflatePrime(&strm, checkpoint.in_bits, *byte_ptr >> (8 - checkpoint.in_bits)) != Z_OK) {
+			throw IOException("Failed to resume inflating entry");
+		}
+	}
+	const auto window_size = checkpoint.window.size();
+	if (window_size > WINDOW_SIZE) {
+		throw IOException("Failed to resume inflating entry: invalid checkpoint");
+	}
+	if (window_size > 0) {
+		const auto dictionary = reinterpret_cast<const Bytef *>(checkpoint.window.data());
+		if (inflateSetDictionary(&strm, dictionary, static_cast<uInt>(window_size)) != Z_OK) {
+			throw IOException("Failed to resume inflating entry");
+		}
+	}
+	out_pos = checkpoint.out_pos;
+	last_checkpoint = out_pos;
+	is_resumed = true;
+	is_done = false;
+	return true;
+}
+
+void ZipEntryInflater::AddCheckpoint() {
+	ZipInflateCheckpoint checkpoint;
+	checkpoint.out_pos = out_pos;
+	checkpoint.in_pos = in_pos - strm.avail_in;
+	checkpoint.in_bits = static_cast<uint8_t>(strm.data_type & 7);
+	// zlib keeps the last 32KB of output in its sliding window anyway
+	checkpoint.window.resize(WINDOW_SIZE);
+	uInt window_size = 0;
+	if (inflateGetDictionary(&strm, reinterpret_cast<Bytef *>(&checkpoint.window[0]), &window_size) != Z_OK) {
+		throw IOException("Failed to record checkpoint");
+	}
+	checkpoint.window.resize(window_size);
+	checkpoints.push_back(std::move(checkpoint));
+	last_checkpoint = out_pos;
+}
+
+idx_t ZipEntryInflater::Read(char *buffer, const idx_t read_size) {
+	idx_t total_size = 0;
+	while (total_size < read_size && !is_done) {
+		if (strm.avail_in == 0) {
+			ReadInput();
+		}
+		const auto avail_out = MinValue<idx_t>(read_size - total_size, NumericLimits<uInt>::Maximum());
+		const auto out_ptr = reinterpret_cast<Bytef *>(buffer + total_size);
+		strm.next_out = out_ptr;
+		strm.avail_out = static_cast<uInt>(avail_out);
+
+		// Stop at the end of every deflate block if we're recording checkpoints
+		const auto status = inflate(&strm, checkpoint_span ? Z_BLOCK : Z_NO_FLUSH);
+		const auto out_size = avail_out - strm.avail_out;
+		if (status != Z_OK && status != Z_STREAM_END && (status != Z_BUF_ERROR || out_size == 0)) {
+			// A buffer error without any output means the compressed data ended early
+			throw IOException("Failed to inflate entry");
+		}
+
+		if (!is_resumed) {
+			crc = static_cast<uint32_t>(crc32(crc, out_ptr, static_cast<uInt>(out_size)));
+		}
+		total_size += out_size;
+		out_pos += out_size;
+
+		if (status == Z_STREAM_END) {
+			is_done = true;
+			break;
+		}
+		// Bit 7 is set at the end of a block, bit 6 if it is the last one
+		const auto at_block_end = (strm.data_type & 128) && !(strm.data_type & 64);
+		if (checkpoint_span && at_block_end && out_pos - last_checkpoint >= checkpoint_span) {
+			AddCheckpoint();
+		}
+	}
+	return total_size;
+}
+
+//-------------------------------------------------------------------------
+// Single-Pass Inflater
+//-------------------------------------------------------------------------
+// Inflates all the compressed data of an entry into memory with a
+// single call to zlib, which then never has to copy anything into its
+// sliding window. Reads point straight into the inflated data.
+//-------------------------------------------------------------------------
+class ZipEntryBufferInflater final : public ZipEntryDecoder {
+public:
+	ZipEntryBufferInflater(ZipFileSource &source, idx_t data_pos, idx_t data_len, idx_t entry_len,
+	                       uint32_t entry_crc);
+
+	idx_t Read(char *buffer, idx_t read_size) override;
+	idx_t ReadBlock(char *buffer, idx_t read_size, const char *&block) override;
+	bool CheckCRC() const override;
+
+private:
+	unsafe_unique_array<Bytef> data;
+	idx_t data_size;
+	idx_t read_pos = 0;
+	uint32_t entry_crc;
+};
+
+ZipEntryBufferInflater::ZipEntryBufferInflater(ZipFileSource &source, const idx_t data_pos, const idx_t data_len,
+                                               const idx_t entry_len, const uint32_t entry_crc_p)
+    : data(make_unsafe_uniq_array_uninitialized<Bytef>(entry_len)), data_size(entry_len), entry_crc(entry_crc_p) {
+	unsafe_unique_array<Bytef> input;
+	if (!source.IsMapped()) {
+		input = make_unsafe_uniq_array_uninitialized<Bytef>(MaxValue<idx_t>(data_len, 1));
+	}
+
+	z_stream strm;
+	memset(&strm, 0, sizeof(strm));
+	// Raw deflate data, without a zlib header
+	if (inflateInit2(&strm, -15) != Z_OK) {
+		throw IOException("Failed to initialize inflater");
+	}
+	strm.next_in = const_cast<Bytef *>(source.Read(input.get(), data_len, data_pos));
+	strm.avail_in = static_cast<uInt>(data_len);
+	strm.next_out = data.get();
+	strm.avail_out = static_cast<uInt>(entry_len);
+	const auto status = inflate(&strm, Z_FINISH);
+	const auto out_size = entry_len - strm.avail_out;
+	inflateEnd(&strm);
+	if (status != Z_STREAM_END || out_size != entry_len) {
+		// Either the compressed data is corrupt, or its size doesn't match the central directory
+		throw IOException("Failed to inflate entry");
+	}
+}
+
+idx_t ZipEntryBufferInflater::Read(char *buffer, const idx_t read_size) {
+	const char *block;
+	const auto block_size = ReadBlock(buffer, read_size, block);
+	memcpy(buffer, block, block_size);
+	return block_size;
+}
+
+idx_t ZipEntryBufferInflater::ReadBlock(char *buffer, const idx_t read_size, const char *&block) {
+	const auto block_size = MinValue(read_size, data_size - read_pos);
+	block = const_char_ptr_cast(data.get() + read_pos);
+	read_pos += block_size;
+	return block_size;
+}
+
+bool ZipEntryBufferInflater::CheckCRC() const {
+	if (read_pos < data_size) {
+		// Not read to the end, don't bother
+		return true;
+	}
+	auto crc = crc32(0, Z_NULL, 0);
+	for (idx_t pos = 0; pos < data_size; pos += NumericLimits<uInt>::Maximum()) {
+		const auto size = MinValue<idx_t>(data_size - pos, NumericLimits<uInt>::Maximum());
+		crc = crc32(crc, data.get() + pos, static_cast<uInt>(size));
+	}
+	return static_cast<uint32_t>(crc) == entry_crc;
+}
+
+//-------------------------------------------------------------------------
+// Stored Entries
+//-------------------------------------------------------------------------
+// Entries that are stored without compression are read straight from
+// the file into the buffer of the reader, or not copied at all if the
+// file is mapped.
+//-------------------------------------------------------------------------
+class ZipEntryStoredReader final : public ZipEntryDecoder {
+public:
+	ZipEntryStoredReader(ZipFileSource &source_p, const idx_t data_pos_p, const idx_t data_len_p,
+	                     const uint32_t entry_crc_p)
+	    : source(source_p), data_pos(data_pos_p), data_len(data_len_p), entry_crc(entry_crc_p) {
+	}
+
+	idx_t Read(char *buffer, idx_t read_size) override;
+	idx_t ReadBlock(char *buffer, idx_t read_size, const char *&block) override;
+	bool CheckCRC() const override {
+		return read_pos < data_len || crc == entry_crc;
+	}
+
+private:
+	ZipFileSource &source;
+	idx_t data_pos;
+	idx_t data_len;
+	idx_t read_pos = 0;
+	uint32_t entry_crc;
+	uint32_t crc = 0;
+};
+
+idx_t ZipEntryStoredReader::Read(char *buffer, const idx_t read_size) {
+	const char *block;
+	const auto block_size = ReadBlock(buffer, read_size, block);
+	if (block != buffer) {
+		memcpy(buffer, block, block_size);
+	}
+	return block_size;
+}
+
+idx_t ZipEntryStoredReader::ReadBlock(char *buffer, const idx_t read_size, const char *&block) {
+	const auto block_size = MinValue(read_size, data_len - read_pos);
+	if (block_size == 0) {
+		block = buffer;
+		return 0;
+	}
+	const auto block_ptr = source.Read(data_ptr_cast(buffer), block_size, data_pos + read_pos);
+	for (idx_t pos = 0; pos < block_size; pos += NumericLimits<uInt>::Maximum()) {
+		const auto size = MinValue<idx_t>(block_size - pos, NumericLimits<uInt>::Maximum());
+		crc = static_cast<uint32_t>(crc32(crc, block_ptr + pos, static_cast<uInt>(size)));
+	}
+	block = const_char_ptr_cast(block_ptr);
+	read_pos += block_size;
+	return block_size;
+}
+
 //-------------------------------------------------------------------------
 // Zip File Writer
 //-------------------------------------------------------------------------
@@ -258,9 +1048,17 @@ idx_t ZipFileWriter::Write(const char *buffer, idx_t write_size) {
 	if (bytes_written < 0) {
 		throw IOException("Failed to write entry");
 	}
+	bytes_deflated += static_cast<idx_t>(bytes_written);
 	return bytes_written;
 }
 
+ZipWriteStats ZipFileWriter::GetStats() const {
+	ZipWriteStats stats;
+	stats.bytes_deflated = bytes_deflated;
+	stats.bytes_written = static_cast<mz_stream_duckdb *>(stream)->bytes_written;
+	return stats;
+}
+
 void ZipFileWriter::EndFile() {
 	if (!is_entry_open) {
 		throw IOException("ZipWriter: Cannot close an entry that is not open");
@@ -313,6 +1111,7 @@ ZipFileReader::ZipFileReader(ClientContext &context, const string &file_name) {
 			throw IOException(duckdb_stream.last_error);
 		}
 	}
+	ReadArchiveTail(duckdb_stream);
 
 	if (mz_zip_reader_open(handle, stream) != MZ_OK) {
 		if (duckdb_stream.last_error.empty()) {
@@ -321,37 +1120,141 @@ ZipFileReader::ZipFileReader(ClientContext &context, const string &file_name) {
 			throw IOException(duckdb_stream.last_error);
 		}
 	}
+
+	Value buffer_size;
+	if (context.TryGetCurrentSetting("xlsx_inflate_buffer_size", buffer_size) && !buffer_size.IsNull()) {
+		inflate_buffer_size = UBigIntValue::Get(buffer_size);
+	}
+
+	auto &file = *duckdb_stream.handle;
+	Value memory_map;
+	if (context.TryGetCurrentSetting("xlsx_memory_map", memory_map) && !memory_map.IsNull() &&
+	    BooleanValue::Get(memory_map)) {
+		mapping = ZipFileMapping::TryMap(file);
+	}
+	source = make_uniq<ZipFileSource>(file, mapping.get(), TaskScheduler::GetScheduler(context));
+
+	fingerprint = CombineHash(Hash(file.GetFileSize()), Hash(fs.GetLastModifiedTime(file).value));
+	BuildIndex();
 }
 
-bool ZipFileReader::TryOpenEntry(const string &file_name) {
-	// Some xlsx producers emit duplicate entry names; per OOXML the last occurrence wins.
-	// Walk all entries and select the last one whose filename matches.
-	int32_t target_index = -1;
-	int32_t current = 0;
+void ZipFileReader::BuildIndex() {
+	void *zip_handle = nullptr;
+	if (mz_zip_reader_get_zip_handle(handle, &zip_handle) != MZ_OK) {
+		throw IOException("ZipReader: Failed to index entries");
+	}
 	auto status = mz_zip_reader_goto_first_entry(handle);
 	while (status == MZ_OK) {
 		mz_zip_file *info = nullptr;
-		if (mz_zip_reader_entry_get_info(handle, &info) == MZ_OK && info != nullptr && info->filename != nullptr) {
-			if (file_name == info->filename) {
-				target_index = current;
-			}
+		if (mz_zip_reader_entry_get_info(handle, &info) != MZ_OK || info == nullptr) {
+			throw IOException("ZipReader: Failed to read entry info while indexing entries");
+		}
+		const auto entry_idx = entry_names.size();
+		entry_names.emplace_back(info->filename ? info->filename : "");
+		entry_offsets.push_back(mz_zip_get_entry(zip_handle));
+		entry_crcs.push_back(info->crc);
+		entry_ranges.emplace_back(NumericCast<idx_t>(MaxValue<int64_t>(info->disk_offset, 0)),
+		                          NumericCast<idx_t>(MaxValue<int64_t>(info->compressed_size, 0)));
+		fingerprint = CombineHash(fingerprint, Hash(entry_names.back().c_str(), entry_names.back().size()));
+		fingerprint = CombineHash(fingerprint, Hash<uint32_t>(info->crc));
+		fingerprint = CombineHash(fingerprint, Hash<int64_t>(info->compressed_size));
+		fingerprint = CombineHash(fingerprint, Hash<int64_t>(info->uncompressed_size));
+		if (info->filename) {
+			// Some xlsx producers emit duplicate entry names; per OOXML the last occurrence wins.
+			entry_index[entry_names.back()] = entry_idx;
 		}
-		current++;
 		status = mz_zip_reader_goto_next_entry(handle);
 	}
-	if (target_index < 0) {
-		return false;
+	if (status != MZ_END_OF_LIST) {
+		throw IOException("ZipReader: Failed to enumerate entries");
 	}
+}
 
-	if (mz_zip_reader_goto_first_entry(handle) != MZ_OK) {
+// Position the reader on an entry, as if it walked there with GotoFirstEntry/GotoNextEntry
+bool ZipFileReader::GotoEntry(const idx_t entry_idx) {
+	if (is_entry_open) {
+		if (decoder) {
+			decoder.reset();
+		} else {
+			mz_zip_reader_entry_close(handle);
+		}
+		is_entry_open = false;
+		entry_pos = 0;
+	}
+	if (entry_idx == 0) {
+		return mz_zip_reader_goto_first_entry(handle) == MZ_OK;
+	}
+	// The reader only keeps track of entries it stepped to itself, so jump to the entry before and step from there
+	void *zip_handle = nullptr;
+	if (mz_zip_reader_get_zip_handle(handle, &zip_handle) != MZ_OK) {
 		return false;
 	}
-	for (int32_t i = 0; i < target_index; i++) {
-		if (mz_zip_reader_goto_next_entry(handle) != MZ_OK) {
-			return false;
+	if (mz_zip_goto_entry(zip_handle, entry_offsets[entry_idx - 1]) != MZ_OK) {
+		return false;
+	}
+	return mz_zip_reader_goto_next_entry(handle) == MZ_OK;
+}
+
+void ZipFileReader::Prefetch(const vector<string> &file_names) {
+	// The local file header is followed by the name and extra field, which are usually the same as in the central
+	// directory but don't have to be, so read a bit more than the compressed data of each entry
+	static constexpr idx_t HEADER_SLACK = 1024;
+	vector<pair<idx_t, idx_t>> ranges;
+	for (auto &file_name : file_names) {
+		const auto entry_idx = FindEntry(file_name);
+		if (entry_idx == DConstants::INVALID_INDEX) {
+			continue;
 		}
+		const auto &range = entry_ranges[entry_idx];
+		if (range.second > MAX_PREFETCH_SIZE) {
+			continue;
+		}
+		ranges.emplace_back(range.first, 30 + file_name.size() + HEADER_SLACK + range.second);
+	}
+	source->Prefetch(std::move(ranges));
+}
+
+bool ZipFileReader::TryOpenEntry(const string &file_name) {
+	const auto entry_idx = FindEntry(file_name);
+	if (entry_idx == DConstants::INVALID_INDEX || !GotoEntry(entry_idx)) {
+		return false;
+	}
+	if (TryOpenDecoder(entry_idx, 0, true)) {
+		return true;
+	}
+	return TryOpenMinizipEntry();
+}
+
+bool ZipFileReader::TryOpenEntry(const string &file_name, const idx_t checkpoint_span) {
+	const auto entry_idx = FindEntry(file_name);
+	if (entry_idx == DConstants::INVALID_INDEX || !GotoEntry(entry_idx)) {
+		return false;
+	}
+	if (TryOpenDecoder(entry_idx, checkpoint_span, false)) {
+		return true;
+	}
+	// Not deflated, open it as usual
+	return TryOpenMinizipEntry();
+}
+
+bool ZipFileReader::TryResumeEntry(const string &file_name, const ZipInflateCheckpoint &checkpoint) {
+	const auto entry_idx = FindEntry(file_name);
+	if (entry_idx == DConstants::INVALID_INDEX || !GotoEntry(entry_idx)) {
+		return false;
+	}
+	// Checkpoints are only recorded for deflated entries
+	if (!TryOpenDecoder(entry_idx, 0, false)) {
+		return false;
+	}
+	if (checkpoint.out_pos > entry_len || !decoder->TryResume(checkpoint)) {
+		CloseEntry();
+		return false;
 	}
+	entry_pos = checkpoint.out_pos;
+	return true;
+}
 
+bool ZipFileReader::TryOpenMinizipEntry() {
 	if (mz_zip_reader_entry_open(handle) != MZ_OK) {
 		return false;
 	}
@@ -363,6 +1266,7 @@ bool ZipFileReader::TryOpenEntry(const string &file_name) {
 
 	const auto len = file_info->uncompressed_size;
 
+	is_inflating = file_info->compression_method == MZ_COMPRESS_METHOD_DEFLATE;
 	is_entry_open = true;
 	entry_pos = 0;
 	entry_len = len;
@@ -370,10 +1274,74 @@ bool ZipFileReader::TryOpenEntry(const string &file_name) {
 	return true;
 }
 
+bool ZipFileReader::TryOpenDecoder(const idx_t entry_idx, const idx_t checkpoint_span, const bool allow_buffer) {
+	mz_zip_file *info = nullptr;
+	if (mz_zip_reader_entry_get_info(handle, &info) != MZ_OK || info == nullptr) {
+		return false;
+	}
+	const auto is_deflated = info->compression_method == MZ_COMPRESS_METHOD_DEFLATE;
+	const auto is_stored = info->compression_method == MZ_COMPRESS_METHOD_STORE;
+	if ((!is_deflated && !is_stored) || (info->flag & MZ_ZIP_FLAG_ENCRYPTED)) {
+		return false;
+	}
+
+	// The compressed data follows the local file header, which has variable length name and extra fields
+	auto &file = *static_cast<mz_stream_duckdb *>(stream)->handle;
+	data_t header_buffer[30];
+	const auto header_pos = NumericCast<idx_t>(info->disk_offset);
+	if (header_pos + sizeof(header_buffer) > file.GetFileSize()) {
+		return false;
+	}
+	const auto header = source->Read(header_buffer, sizeof(header_buffer), header_pos);
+	if (header[0] != 'P' || header[1] != 'K' || header[2] != 3 || header[3] != 4) {
+		return false;
+	}
+	const auto name_len = static_cast<idx_t>(header[26] | header[27] << 8);
+	const auto extra_len = static_cast<idx_t>(header[28] | header[29] << 8);
+	const auto data_pos = header_pos + sizeof(header_buffer) + name_len + extra_len;
+	const auto data_len = NumericCast<idx_t>(info->compressed_size);
+	if (data_pos + data_len > file.GetFileSize()) {
+		return false;
+	}
+
+	const auto len = NumericCast<idx_t>(info->uncompressed_size);
+	const auto crc = entry_crcs[entry_idx];
+	// zlib takes 32-bit buffer sizes, anything larger is always streamed
+	const auto max_buffer_size = MinValue<idx_t>(inflate_buffer_size, NumericLimits<uInt>::Maximum());
+	is_inflating = false;
+	if (is_stored) {
+		if (data_len != len) {
+			return false;
+		}
+		decoder = make_uniq<ZipEntryStoredReader>(*source, data_pos, data_len, crc);
+	} else if (allow_buffer && len > 0 && len <= max_buffer_size && data_len <= max_buffer_size) {
+		// Inflated right away
+		decoder = make_uniq<ZipEntryBufferInflater>(*source, data_pos, data_len, len, crc);
+		bytes_inflated += len;
+	} else {
+		decoder = make_uniq<ZipEntryInflater>(*source, data_pos, data_len, crc, checkpoint_span);
+		is_inflating = true;
+	}
+	is_entry_open = true;
+	entry_pos = 0;
+	entry_len = len;
+	return true;
+}
+
 void ZipFileReader::CloseEntry() {
 	if (!is_entry_open) {
 		throw IOException("ZipReader: Cannot close an entry that is not open");
 	}
+	if (decoder) {
+		const auto crc_ok = decoder->CheckCRC();
+		decoder.reset();
+		is_entry_open = false;
+		entry_pos = 0;
+		if (!crc_ok) {
+			throw IOException("Failed to close entry");
+		}
+		return;
+	}
 	const auto close_result = mz_zip_reader_entry_close(handle);
 	if (close_result != MZ_OK) {
 		const auto is_early_exit = close_result == MZ_CRC_ERROR && entry_pos < entry_len;
@@ -388,14 +1356,58 @@ void ZipFileReader::CloseEntry() {
 }
 
 idx_t ZipFileReader::Read(char *buffer, const idx_t read_size) {
+	if (decoder) {
+		const auto bytes_read = decoder->Read(buffer, read_size);
+		entry_pos += bytes_read;
+		bytes_inflated += is_inflating ? bytes_read : 0;
+		return bytes_read;
+	}
 	const auto bytes_read = mz_zip_reader_entry_read(handle, buffer, static_cast<int32_t>(read_size));
 	if (bytes_read < 0) {
 		throw IOException("Failed to read entry");
 	}
 	entry_pos += bytes_read;
+	bytes_inflated += is_inflating ? static_cast<idx_t>(bytes_read) : 0;
+	return bytes_read;
+}
+
+idx_t ZipFileReader::ReadBlock(char *buffer, const idx_t read_size, const char *&block) {
+	if (!decoder) {
+		block = buffer;
+		return Read(buffer, read_size);
+	}
+	const auto bytes_read = decoder->ReadBlock(buffer, read_size, block);
+	entry_pos += bytes_read;
+	bytes_inflated += is_inflating ? bytes_read : 0;
 	return bytes_read;
 }
 
+idx_t ZipFileReader::Skip(const idx_t skip_size) {
+	char buffer[8192];
+	idx_t total_size = 0;
+	while (total_size < skip_size) {
+		const char *block;
+		const auto read_size = ReadBlock(buffer, MinValue<idx_t>(sizeof(buffer), skip_size - total_size), block);
+		if (read_size == 0) {
+			break;
+		}
+		total_size += read_size;
+	}
+	return total_size;
+}
+
+const vector<ZipInflateCheckpoint> &ZipFileReader::GetCheckpoints() const {
+	static const vector<ZipInflateCheckpoint> no_checkpoints;
+	return decoder ? decoder->GetCheckpoints() : no_checkpoints;
+}
+
+ZipReadStats ZipFileReader::GetStats() const {
+	ZipReadStats stats;
+	stats.bytes_read = static_cast<mz_stream_duckdb *>(stream)->bytes_read + source->bytes_read;
+	stats.bytes_inflated = bytes_inflated;
+	return stats;
+}
+
 idx_t ZipFileReader::GetEntryPos() const {
 	return entry_pos;
 }
@@ -408,34 +1420,32 @@ bool ZipFileReader::IsDone() const {
 	return entry_pos >= entry_len;
 }
 
-vector<string> ZipFileReader::ListEntries() {
-	if (is_entry_open) {
-		throw IOException("ZipReader: Cannot list entries while an entry is open");
-	}
-	vector<string> entries;
-	auto status = mz_zip_reader_goto_first_entry(handle);
-	while (status == MZ_OK) {
-		mz_zip_file *info = nullptr;
-		if (mz_zip_reader_entry_get_info(handle, &info) != MZ_OK || info == nullptr) {
-			throw IOException("ZipReader: Failed to read entry info while listing entries");
-		}
-		entries.emplace_back(info->filename);
-		status = mz_zip_reader_goto_next_entry(handle);
-	}
-	if (status != MZ_END_OF_LIST && status != MZ_OK) {
-		throw IOException("ZipReader: Failed to enumerate entries");
-	}
-	return entries;
+const vector<string> &ZipFileReader::ListEntries() const {
+	return entry_names;
+}
+
+idx_t ZipFileReader::FindEntry(const string &entry_name) const {
+	const auto entry = entry_index.find(entry_name);
+	return entry == entry_index.end() ? DConstants::INVALID_INDEX : entry->second;
+}
+
+hash_t ZipFileReader::GetFingerprint() const {
+	return fingerprint;
+}
+
+uint32_t ZipFileReader::GetEntryCRC(const idx_t entry_idx) const {
+	return entry_crcs[entry_idx];
 }
 
 bool ZipFileReader::EntryIsDirectory(const string &entry_name) {
 	if (is_entry_open) {
 		throw IOException("ZipReader: Cannot inspect entries while another is open");
 	}
-	if (mz_zip_reader_locate_entry(handle, entry_name.c_str(), 0) != MZ_OK) {
+	const auto entry_idx = FindEntry(entry_name);
+	if (entry_idx == DConstants::INVALID_INDEX || !GotoEntry(entry_idx)) {
 		return false;
 	}
-	return mz_zip_entry_is_dir(handle) == MZ_OK;
+	return mz_zip_reader_entry_is_dir(handle) == MZ_OK;
 }
 
 bool ZipFileReader::GotoFirstEntry() {
@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Serve a directory over HTTP, with the range requests httpfs relies on.
+
+Used by the tests that read workbooks over HTTP. Run it from the directory the tests are run from, so that the files
+the tests write to __TEST_DIR__ are served as well:
+
+    python3 test/http_server.py 8008 &
+    XLSX_TEST_HTTP_SERVER=http://localhost:8008 make test
+"""
+
+import argparse
+import functools
+import http.server
+import io
+import os
+import re
+
+RANGE_PATTERN = re.compile(r'bytes=(\d+)-(\d*)')
+
+
+class RangeRequestHandler(http.server.SimpleHTTPRequestHandler):
+    def send_head(self):
+        path = self.translate_path(self.path)
+        if not os.path.isfile(path):
+            self.send_error(404, 'File not found')
+            return None
+        with open(path, 'rb') as f:
+            stat = os.fstat(f.fileno())
+            size = stat.st_size
+            match = RANGE_PATTERN.fullmatch(self.headers.get('Range', ''))
+            if match:
+                beg = int(match[1])
+                end = min(int(match[2]) if match[2] else size - 1, size - 1)
+                if beg > end:
+                    self.send_response(416)
+                    self.send_header('Content-Range', f'bytes */{size}')
+                    self.end_headers()
+                    return None
+                self.send_response(206)
+                self.send_header('Content-Range', f'bytes {beg}-{end}/{size}')
+            else:
+                beg, end = 0, size - 1
+                self.send_response(200)
+            f.seek(beg)
+            data = f.read(end - beg + 1)
+        self.send_header('Content-Type', 'application/octet-stream')
+        self.send_header('Content-Length', str(len(data)))
+        self.send_header('Accept-Ranges', 'bytes')
+        self.send_header('Last-Modified', self.date_time_string(stat.st_mtime))
+        self.end_headers()
+        return io.BytesIO(data)
+
+    def log_message(self, format, *args):
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('port', type=int, nargs='?', default=8008)
+    parser.add_argument('--directory', default=os.getcwd())
+    args = parser.parse_args()
+
+    handler = functools.partial(RangeRequestHandler, directory=args.directory)
+    with http.server.ThreadingHTTPServer(('localhost', args.port), handler) as server:
+        server.serve_forever()
+
+
+if __name__ == '__main__':
+    main()